@@ -0,0 +1,241 @@
+#ifndef NUMERIC_LITERAL_HPP
+#define NUMERIC_LITERAL_HPP
+
+#include <cfloat>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+/// @brief Outcome of converting a numeric literal
+enum class LiteralStatus : unsigned char
+{
+    OK,
+    /// @brief The literal does not fit the target type, the value is saturated
+    OUT_OF_RANGE,
+    /// @brief No digit at the start of the input
+    INVALID
+};
+
+/// @brief Result of *parse_integer_literal()*
+struct IntegerLiteral
+{
+    LiteralStatus status;
+    /// @brief INT_MAX when status is *OUT_OF_RANGE*
+    int value;
+    /// @brief Number of characters consumed
+    std::size_t length;
+};
+
+/// @brief Result of *parse_real_literal()*
+struct RealLiteral
+{
+    LiteralStatus status;
+    double value;
+    /// @brief Number of characters consumed
+    std::size_t length;
+};
+
+/// @note Literal parsing shared by every version of the interpreter.
+/// Conversions read the source bytes directly, without going through std::string,
+/// the locale or exceptions.
+
+namespace numeric_literal_detail
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    constexpr bool kCanUseSwar = true;
+#else
+    constexpr bool kCanUseSwar = false;
+#endif
+
+    inline bool is_digit(char c) noexcept { return static_cast<unsigned char>(c - '0') <= 9; }
+
+    inline std::uint64_t load_eight_bytes(const char *data) noexcept
+    {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, data, sizeof(chunk));
+        return chunk;
+    }
+
+    /// @brief Whether the 8 bytes of *chunk* are all ASCII digits (SWAR)
+    inline bool is_eight_digits(std::uint64_t chunk) noexcept
+    {
+        return ((chunk & 0xF0F0F0F0F0F0F0F0ull) |
+                (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+    }
+
+    /// @brief Convert 8 ASCII digits at once, first digit in the lowest byte (SWAR)
+    inline std::uint32_t parse_eight_digits(std::uint64_t chunk) noexcept
+    {
+        chunk = (chunk & 0x0F0F0F0F0F0F0F0Full) * 2561 >> 8;
+        chunk = (chunk & 0x00FF00FF00FF00FFull) * 6553601 >> 16;
+        return static_cast<std::uint32_t>((chunk & 0x0000FFFF0000FFFFull) * 42949672960001ull >> 32);
+    }
+
+    /// @brief Number of digits of *value* without leading zeros, 0 for 0
+    inline std::size_t count_digits(std::uint32_t value) noexcept
+    {
+        std::size_t count = 0;
+        for (; value != 0; value /= 10)
+        {
+            count++;
+        }
+        return count;
+    }
+
+    /// @brief Accumulate a run of digits into *mantissa*, 8 digits at a time when possible.
+    /// @note Stops accumulating (but keeps consuming) once *mantissa* would exceed 19 significant
+    /// digits, *dropped* counts the digits that did not fit.
+    /// @return Position of the first non-digit character
+    inline std::size_t accumulate_digits(const char *data, std::size_t pos, std::size_t length,
+                                         std::uint64_t &mantissa, std::size_t &significant,
+                                         std::size_t &dropped) noexcept
+    {
+        constexpr std::size_t kMaxSignificantDigits = 19;
+        while (kCanUseSwar && pos + 8 <= length && significant + 8 <= kMaxSignificantDigits)
+        {
+            std::uint64_t chunk = load_eight_bytes(data + pos);
+            if (!is_eight_digits(chunk))
+            {
+                break;
+            }
+            std::uint32_t digits = parse_eight_digits(chunk);
+            /// @note Leading zeros of the literal are not significant
+            significant += (mantissa != 0) ? 8 : count_digits(digits);
+            mantissa = mantissa * 100000000ull + digits;
+            pos += 8;
+        }
+
+        while (pos < length && is_digit(data[pos]))
+        {
+            if (significant < kMaxSignificantDigits)
+            {
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(data[pos] - '0');
+                significant += (mantissa != 0) ? 1 : 0;
+            }
+            else
+            {
+                dropped++;
+            }
+            pos++;
+        }
+        return pos;
+    }
+
+    /// @brief Exactly representable powers of ten
+    constexpr double kExactPowersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    /// @brief Slow path: correctly rounded conversion of "<digits>e-<fraction_digits>" by strtod.
+    /// @note The decimal point is removed beforehand, so the locale never matters.
+    /// Only literals longer than ~100 characters need a heap buffer.
+    inline double convert_slow(const char *data, std::size_t length, std::size_t fraction_digits)
+    {
+        /// @note digits + 'e' + '-' + up to 20 exponent digits + '\0'
+        constexpr std::size_t kSuffixCapacity = 24;
+        char stack_buffer[128];
+        std::string heap_buffer;
+        char *buffer = stack_buffer;
+        if (length + kSuffixCapacity > sizeof(stack_buffer))
+        {
+            heap_buffer.resize(length + kSuffixCapacity);
+            buffer = &heap_buffer[0];
+        }
+
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < length; i++)
+        {
+            if (is_digit(data[i]))
+            {
+                buffer[size++] = data[i];
+            }
+        }
+        buffer[size++] = 'e';
+        buffer[size++] = '-';
+
+        char exponent[kSuffixCapacity];
+        std::size_t exponent_size = 0;
+        do
+        {
+            exponent[exponent_size++] = static_cast<char>('0' + fraction_digits % 10);
+            fraction_digits /= 10;
+        } while (fraction_digits > 0);
+        while (exponent_size > 0)
+        {
+            buffer[size++] = exponent[--exponent_size];
+        }
+        buffer[size] = '\0';
+
+        return std::strtod(buffer, nullptr);
+    }
+}
+
+/// @brief Convert the run of decimal digits at the start of data[0, length) to an int.
+inline IntegerLiteral parse_integer_literal(const char *data, std::size_t length) noexcept
+{
+    using namespace numeric_literal_detail;
+
+    std::uint64_t mantissa = 0;
+    std::size_t significant = 0;
+    std::size_t dropped = 0;
+    std::size_t end = accumulate_digits(data, 0, length, mantissa, significant, dropped);
+
+    if (end == 0)
+    {
+        return {LiteralStatus::INVALID, 0, 0};
+    }
+    if (dropped > 0 || mantissa > static_cast<std::uint64_t>(INT_MAX))
+    {
+        return {LiteralStatus::OUT_OF_RANGE, INT_MAX, end};
+    }
+    return {LiteralStatus::OK, static_cast<int>(mantissa), end};
+}
+
+/// @brief Convert the literal "digits [. digits]" at the start of data[0, length) to the
+/// correctly rounded double.
+inline RealLiteral parse_real_literal(const char *data, std::size_t length)
+{
+    using namespace numeric_literal_detail;
+
+    std::uint64_t mantissa = 0;
+    std::size_t significant = 0;
+    std::size_t dropped = 0;
+    std::size_t end = accumulate_digits(data, 0, length, mantissa, significant, dropped);
+    if (end == 0)
+    {
+        return {LiteralStatus::INVALID, 0.0, 0};
+    }
+
+    std::size_t fraction_digits = 0;
+    if (end < length && data[end] == '.')
+    {
+        std::size_t fraction_start = end + 1;
+        end = accumulate_digits(data, fraction_start, length, mantissa, significant, dropped);
+        fraction_digits = end - fraction_start;
+    }
+
+    /// @note Clinger's fast path: when every digit fits the mantissa, value = mantissa / 10^fraction_digits.
+    /// If both operands are exact doubles, a single IEEE division is correctly rounded.
+    constexpr std::uint64_t kMaxExactMantissa = 1ull << 53;
+    constexpr std::size_t kMaxExactPowerOfTen = 22;
+    double value;
+    if (dropped == 0 && mantissa <= kMaxExactMantissa && fraction_digits <= kMaxExactPowerOfTen)
+    {
+        value = static_cast<double>(mantissa) / kExactPowersOfTen[fraction_digits];
+    }
+    else
+    {
+        value = convert_slow(data, end, fraction_digits);
+    }
+
+    if (value > DBL_MAX)
+    {
+        return {LiteralStatus::OUT_OF_RANGE, value, end};
+    }
+    return {LiteralStatus::OK, value, end};
+}
+
+#endif
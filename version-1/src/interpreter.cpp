@@ -6,7 +6,7 @@
 #include "lexer.hpp"
 #include "utils.hpp"
 
-std::string ASTNodeVisitor::_visit(ASTNode *node)
+int ASTNodeVisitor::_visit(ASTNode *node)
 {
     switch (node->getType())
     {
@@ -15,7 +15,7 @@ std::string ASTNodeVisitor::_visit(ASTNode *node)
         /// @note Using static_cast to prevent runtime checking for better performance.
         /// If you want your program to be safer, please use dynamic_cast.
         NumNode *num_node = static_cast<NumNode *>(node);
-        return num_node->getToken()->getValue();
+        return num_node->getToken()->getIntValue();
     }
     case ASTNodeType::UNARY_OPERATOR:
     {
@@ -29,7 +29,7 @@ std::string ASTNodeVisitor::_visit(ASTNode *node)
         }
         else if (token->getType() == TokenType::MINUS)
         {
-            return std::to_string(-std::stoi(_visit(unary_op_node->getChild())));
+            return -_visit(unary_op_node->getChild());
         }
 
         __THROW_INVALID_AST_NODE_ERROR
@@ -43,23 +43,19 @@ std::string ASTNodeVisitor::_visit(ASTNode *node)
         {
         case TokenType::PLUS:
         {
-            return std::to_string(
-                std::stoi(_visit(bin_op_node->getLeftChild())) + std::stoi(_visit(bin_op_node->getRightChild())));
+            return _visit(bin_op_node->getLeftChild()) + _visit(bin_op_node->getRightChild());
         }
         case TokenType::MINUS:
         {
-            return std::to_string(
-                std::stoi(_visit(bin_op_node->getLeftChild())) - std::stoi(_visit(bin_op_node->getRightChild())));
+            return _visit(bin_op_node->getLeftChild()) - _visit(bin_op_node->getRightChild());
         }
         case TokenType::MUL:
         {
-            return std::to_string(
-                std::stoi(_visit(bin_op_node->getLeftChild())) * std::stoi(_visit(bin_op_node->getRightChild())));
+            return _visit(bin_op_node->getLeftChild()) * _visit(bin_op_node->getRightChild());
         }
         case TokenType::DIV:
         {
-            return std::to_string(
-                std::stoi(_visit(bin_op_node->getLeftChild())) / std::stoi(_visit(bin_op_node->getRightChild())));
+            return _visit(bin_op_node->getLeftChild()) / _visit(bin_op_node->getRightChild());
         }
         default:
             __THROW_INVALID_AST_NODE_ERROR
@@ -70,7 +66,7 @@ std::string ASTNodeVisitor::_visit(ASTNode *node)
     }
 }
 
-std::string ASTWalker::_walk(AST *ast)
+int ASTWalker::_walk(AST *ast)
 {
     return _visit(ast->getRoot());
 }
@@ -82,7 +78,7 @@ Interpreter::Interpreter(Parser *parser) : _parser(parser)
 std::string Interpreter::interpret()
 {
     AST *ast = _parser->parse();
-    std::string result = _walk(ast);
+    int result = _walk(ast);
     delete ast;
-    return result;
+    return std::to_string(result);
 }
\ No newline at end of file
@@ -10,13 +10,13 @@
 class ASTNodeVisitor
 {
 protected:
-    std::string _visit(ASTNode *node);
+    int _visit(ASTNode *node);
 };
 
 class ASTWalker : protected ASTNodeVisitor
 {
 protected:
-    std::string _walk(AST *ast);
+    int _walk(AST *ast);
 };
 
 class Interpreter : protected ASTWalker
@@ -2,6 +2,7 @@
 #include <stdexcept>
 #include <cctype>
 #include "lexer.hpp"
+#include "numeric_literal.hpp"
 #include "token.hpp"
 #include "utils.hpp"
 
@@ -33,16 +34,22 @@ void Lexer::_skip_whitespace() noexcept
     }
 }
 
-std::string Lexer::_integer() noexcept
+Token *Lexer::_integer()
 {
-    std::string result = "";
-    while (_current_char != NULL_CHAR && std::isdigit(_current_char))
+    /// @note The value is converted once here, the interpreter reads it from the token
+    IntegerLiteral literal = parse_integer_literal(_text.data() + _pos, _text.length() - _pos);
+    if (literal.status == LiteralStatus::OUT_OF_RANGE)
+    {
+        __THROW_INTEGER_OUT_OF_RANGE_ERROR
+    }
+
+    std::string text = _text.substr(_pos, literal.length);
+    for (std::size_t i = 0; i < literal.length; i++)
     {
-        result.push_back(_current_char);
         _advance();
     }
 
-    return result;
+    return new Token(TokenType::INTEGER, text, literal.value);
 }
 
 Token *Lexer::get_next_token()
@@ -57,7 +64,7 @@ Token *Lexer::get_next_token()
 
         if (std::isdigit(_current_char))
         {
-            return new Token(TokenType::INTEGER, _integer());
+            return _integer();
         }
 
         if (_current_char == PLUS_CHAR)
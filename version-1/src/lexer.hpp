@@ -22,8 +22,9 @@ private:
 
     void _skip_whitespace() noexcept;
 
-    /// @brief Return a (multidigit) integer string consumed from the input.
-    std::string _integer() noexcept;
+    /// @brief Return a (multidigit) INTEGER token consumed from the input.
+    /// @note Throws if the literal does not fit an int
+    Token *_integer();
 
 public:
     Lexer(const std::string &text);
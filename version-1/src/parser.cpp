@@ -33,81 +33,106 @@ void Parser::_eat(TokenType token_type)
     }
 }
 
-ASTNode *Parser::_factor()
+/// @brief Binding power of a binary operator, 0 for other tokens
+static unsigned char _binary_precedence(TokenType type)
 {
-    Token *token = _current_token;
-    if (token->getType() == TokenType::PLUS)
+    switch (type)
     {
-        _eat(TokenType::PLUS);
-        return new UnaryOpNode(token, _factor());
+    case TokenType::PLUS:
+    case TokenType::MINUS:
+        return 1;
+    case TokenType::MUL:
+    case TokenType::DIV:
+        return 2;
+    default:
+        return 0;
     }
-    else if (token->getType() == TokenType::MINUS)
-    {
-        _eat(TokenType::MINUS);
-        return new UnaryOpNode(token, _factor());
-    }
-    else if (token->getType() == TokenType::INTEGER)
-    {
-        _eat(TokenType::INTEGER);
-        return new NumNode(token);
-    }
-    else if (token->getType() == TokenType::LPAREN)
+}
+
+void Parser::_reduce_unary()
+{
+    while (!_operators.empty() && _operators.back().is_unary)
     {
-        _eat(TokenType::LPAREN);
-        delete token; // delete LPAREN token pointer
-        ASTNode *node = _expr();
-        token = _current_token;
-        _eat(TokenType::RPAREN);
-        delete token; // delete RPAREN token pointer
-        return node;
+        Token *token = _operators.back().token;
+        _operators.pop_back();
+        _operands.back() = new UnaryOpNode(token, _operands.back());
     }
-
-    __THROW_PARSING_ERROR
 }
 
-ASTNode *Parser::_term()
+void Parser::_reduce_binary(unsigned char precedence)
 {
-    ASTNode *node = _factor();
-    while (_current_token != nullptr &&
-           (_current_token->getType() == TokenType::MUL || _current_token->getType() == TokenType::DIV))
+    while (!_operators.empty() && !_operators.back().is_unary &&
+           _binary_precedence(_operators.back().token->getType()) >= precedence)
     {
-        Token *token = _current_token;
-        if (token->getType() == TokenType::MUL)
-        {
-            _eat(TokenType::MUL);
-        }
-        else if (token->getType() == TokenType::DIV)
-        {
-            _eat(TokenType::DIV);
-        }
+        Token *token = _operators.back().token;
+        _operators.pop_back();
 
-        node = new BinOpNode(token, node, _factor());
+        ASTNode *right = _operands.back();
+        _operands.pop_back();
+        _operands.back() = new BinOpNode(token, _operands.back(), right);
     }
-
-    return node;
 }
 
 ASTNode *Parser::_expr()
 {
-    ASTNode *node = _term();
-
-    while (_current_token != nullptr &&
-           (_current_token->getType() == TokenType::PLUS ||
-            _current_token->getType() == TokenType::MINUS))
+    std::size_t open_parenthesis_count = 0;
+    bool expect_operand = true;
+    while (true)
     {
         Token *token = _current_token;
-        if (token->getType() == TokenType::PLUS)
+        if (expect_operand)
         {
-            _eat(TokenType::PLUS);
+            if (token->getType() == TokenType::PLUS || token->getType() == TokenType::MINUS ||
+                token->getType() == TokenType::LPAREN)
+            {
+                _eat(token->getType());
+                _operators.push_back(PendingOperator{token, token->getType() != TokenType::LPAREN});
+                open_parenthesis_count += (token->getType() == TokenType::LPAREN) ? 1 : 0;
+                continue;
+            }
+
+            _eat(TokenType::INTEGER);
+            _operands.push_back(new NumNode(token));
+            _reduce_unary();
+            expect_operand = false;
+            continue;
         }
-        else if (token->getType() == TokenType::MINUS)
+
+        unsigned char precedence = _binary_precedence(token->getType());
+        if (precedence != 0)
         {
-            _eat(TokenType::MINUS);
+            // binary operators are left-associative, equal precedences are built first
+            _reduce_binary(precedence);
+            _eat(token->getType());
+            _operators.push_back(PendingOperator{token, false});
+            expect_operand = true;
+            continue;
         }
 
-        node = new BinOpNode(token, node, _term());
+        if (token->getType() == TokenType::RPAREN && open_parenthesis_count > 0)
+        {
+            _reduce_binary(1);
+            _eat(TokenType::RPAREN);
+            delete token; // delete RPAREN token pointer
+            delete _operators.back().token; // delete LPAREN token pointer
+            _operators.pop_back();
+            --open_parenthesis_count;
+            // a parenthesized expression is a factor, signs before it apply to all of it
+            _reduce_unary();
+            continue;
+        }
+
+        break;
+    }
+
+    if (open_parenthesis_count > 0)
+    {
+        _eat(TokenType::RPAREN);
     }
+    _reduce_binary(1);
 
+    ASTNode *node = _operands.back();
+    _operands.pop_back();
     return node;
 }
 
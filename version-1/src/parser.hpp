@@ -1,24 +1,40 @@
 #ifndef PARSER_HPP
 #define PARSER_HPP
 
+#include <vector>
 #include "ast.hpp"
 #include "lexer.hpp"
 
 class Parser
 {
 private:
+    /// @brief Operator waiting for its operands, or an open parenthesis (LPAREN token)
+    struct PendingOperator
+    {
+        Token *token;
+        bool is_unary;
+    };
+
     Token *_current_token = nullptr;
 
     Lexer *_lexer;
 
+    std::vector<ASTNode *> _operands;
+    std::vector<PendingOperator> _operators;
+
     void _error() const;
 
     void _eat(TokenType token_type);
 
-    ASTNode *_factor();
+    /// @brief Build the unary operators on top of the operator stack around the top operand
+    void _reduce_unary();
 
-    ASTNode *_term();
+    /// @brief Build the binary operators on top of the operator stack binding at least
+    /// as tightly as *precedence*, stopping at an open parenthesis
+    void _reduce_binary(unsigned char precedence);
 
+    /// @brief Precedence climbing over explicit operand/operator stacks, builds the
+    /// tree of the grammar in ebnf.md without recursing for nested factors
     ASTNode *_expr();
 
 public:
@@ -4,7 +4,8 @@
 
 Token::Token(TokenType type) : Token(type, "") {}
 Token::Token(TokenType type, const char value) : Token(type, std::string{value}) {}
-Token::Token(TokenType type, const std::string &value) : _type{type}, _value{value} {}
+Token::Token(TokenType type, const std::string &value, int int_value)
+    : _type{type}, _value{value}, _int_value{int_value} {}
 
 TokenType Token::getType() const noexcept
 {
@@ -14,4 +15,9 @@ TokenType Token::getType() const noexcept
 const std::string &Token::getValue() const noexcept
 {
     return _value;
+}
+
+int Token::getIntValue() const noexcept
+{
+    return _int_value;
 }
\ No newline at end of file
@@ -9,14 +9,17 @@ class Token
 private:
     const TokenType _type;
     const std::string _value;
+    /// @brief Value of an INTEGER token, converted by the lexer
+    const int _int_value;
 
 public:
     Token(TokenType type);
     Token(TokenType type, const char value);
-    Token(TokenType type, const std::string &value);
+    Token(TokenType type, const std::string &value, int int_value = 0);
 
     TokenType getType() const noexcept;
     const std::string &getValue() const noexcept;
+    int getIntValue() const noexcept;
 };
 
 #endif
\ No newline at end of file
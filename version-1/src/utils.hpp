@@ -7,6 +7,9 @@
 #define __THROW_INVALID_AST_NODE_ERROR \
     throw std::runtime_error("Invalid AST node");
 
+#define __THROW_INTEGER_OUT_OF_RANGE_ERROR \
+    throw std::runtime_error("Integer literal out of range");
+
 constexpr char NULL_CHAR = '\0';
 constexpr char WHITESPACE_CHAR = ' ';
 constexpr char PLUS_CHAR = '+';
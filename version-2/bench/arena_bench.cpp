@@ -0,0 +1,33 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "ast.hpp"
+#include "bench_program.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Parse and tear down ASTs of growing programs, the teardown must not grow with them
+int main()
+{
+    const std::size_t kStatementCounts[] = {10000, 100000, 1000000};
+    for (std::size_t statement_count : kStatementCounts)
+    {
+        std::string program = make_bench_program(statement_count);
+        Lexer lexer(program);
+        TokenBuffer tokens = lexer.tokenize();
+
+        AbstractSyntaxTree *ast = nullptr;
+        double parse_ms = measure_ms([&]() {
+            Parser parser(&tokens);
+            ast = parser.parse();
+        });
+        std::size_t arena_bytes = ast->get_arena().get_reserved_bytes();
+        double teardown_ms = measure_ms([&]() { delete ast; });
+
+        std::cout << statement_count << " statements: parse " << parse_ms << " ms, teardown "
+                  << teardown_ms << " ms, arena " << arena_bytes / 1024 << " KiB\n";
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,72 @@
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "ast.hpp"
+#include "ast_file.hpp"
+#include "bench_program.hpp"
+#include "flat_ast.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Touch every node, so that loading is not measured without reading the pages it mapped
+static long long sum_literals(const FlatAst &ast)
+{
+    long long sum = 0;
+    for (NodeIndex node = 0; node < ast.get_node_count(); ++node)
+    {
+        if (ast.get_kind(node) == AstNodeType::INT_NUM)
+        {
+            sum += ast.get_int_value(node);
+        }
+    }
+    return sum;
+}
+
+/// @brief Time to get a flat tree from the source (lex, parse, flatten) versus from a saved *AstFile*
+int main()
+{
+    constexpr std::size_t kStatementCount = 1000000;
+    constexpr int kRepeatCount = 5;
+    const std::string path = "ast_file_bench.ast";
+    std::string program = make_bench_program(kStatementCount);
+
+    long long parsed_sum = 0;
+    double parse_ms = measure_ms([&]() {
+        for (int i = 0; i < kRepeatCount; ++i)
+        {
+            Lexer lexer(program);
+            TokenBuffer tokens = lexer.tokenize();
+            Parser parser(&tokens);
+            std::unique_ptr<AbstractSyntaxTree> ast(parser.parse());
+            FlatAst flat_ast(ast.get());
+            parsed_sum += sum_literals(flat_ast);
+        }
+    });
+
+    Lexer lexer(program);
+    TokenBuffer tokens = lexer.tokenize();
+    Parser parser(&tokens);
+    std::unique_ptr<AbstractSyntaxTree> ast(parser.parse());
+    FlatAst flat_ast(ast.get());
+    double save_ms = measure_ms([&]() { AstFile::save(flat_ast, path); });
+
+    long long loaded_sum = 0;
+    double load_ms = measure_ms([&]() {
+        for (int i = 0; i < kRepeatCount; ++i)
+        {
+            std::unique_ptr<FlatAst> loaded_ast(AstFile::load(path));
+            loaded_sum += sum_literals(*loaded_ast);
+        }
+    });
+    std::remove(path.c_str());
+
+    std::cout << flat_ast.get_node_count() << " nodes, saved in " << save_ms << " ms\n";
+    std::cout << "lex + parse + flatten: " << parse_ms / kRepeatCount << " ms per tree\n";
+    std::cout << "load (mmap):           " << load_ms / kRepeatCount << " ms per tree, "
+              << parse_ms / load_ms << "x faster\n";
+
+    return (parsed_sum == loaded_sum) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,61 @@
+#ifndef BENCH_PROGRAM_HPP
+#define BENCH_PROGRAM_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/// @brief Generate a well-typed PROGRAM with *statement_count* assignments
+/// over *variable_count* INTEGER and as many REAL variables.
+/// @note Every statement is preceded by a *comment_length* characters comment
+/// (none if 0), mimicking machine-generated sources.
+inline std::string make_bench_program(std::size_t statement_count,
+                                      std::size_t variable_count = 64,
+                                      std::size_t comment_length = 0)
+{
+    std::string program = "PROGRAM Bench;\nVAR\n";
+    for (std::size_t i = 0; i < variable_count; i++)
+    {
+        program += "    i" + std::to_string(i) + " : INTEGER;\n";
+        program += "    r" + std::to_string(i) + " : REAL;\n";
+    }
+
+    const std::string comment = (comment_length >= 2)
+                                    ? "{" + std::string(comment_length - 2, 'c') + "}"
+                                    : std::string();
+
+    program += "BEGIN\n";
+    for (std::size_t i = 0; i < statement_count; i++)
+    {
+        std::string a = std::to_string(i % variable_count);
+        /// @note Statements read variables the program assigns (INTEGER ones at even indexes,
+        /// REAL ones at odd indexes), so none of them is redundant
+        std::string b = std::to_string((i * 7 + 4) % variable_count);
+        std::string c = std::to_string((i * 14 + 6) % variable_count);
+
+        program += "    " + comment;
+        if (i % 2 == 0)
+        {
+            program += "i" + a + " := i" + b + " * 12 + (i" + c + " DIV 3) - 7;\n";
+        }
+        else
+        {
+            program += "r" + a + " := r" + b + " / 2.5 + i" + c + " * 1.25;\n";
+        }
+    }
+    program += "END.\n";
+
+    return program;
+}
+
+/// @brief Wall-clock milliseconds spent in *body*
+template <typename TBody>
+inline double measure_ms(TBody body)
+{
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+#endif
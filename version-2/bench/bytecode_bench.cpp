@@ -0,0 +1,67 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "ast.hpp"
+#include "bench_program.hpp"
+#include "bytecode.hpp"
+#include "interpreter.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "semantic_analyzer.hpp"
+#include "stack_vm.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Statements per second of the tree-walking *Interpreter* and of the *StackVm*
+/// running the same analyzed program
+int main()
+{
+    constexpr std::size_t kStatementCount = 1000000;
+    constexpr int kRepeatCount = 5;
+    std::string program = make_bench_program(kStatementCount);
+    Lexer lexer(program);
+    TokenBuffer tokens = lexer.tokenize();
+    Parser parser(&tokens);
+    std::unique_ptr<AbstractSyntaxTree> ast(parser.parse());
+    SemanticAnalyzer analyzer(ast.get());
+    analyzer.analyze();
+
+    BytecodeProgram bytecode;
+    double compile_ms = measure_ms([&]() { bytecode = BytecodeCompiler(analyzer).compile(); });
+    std::cout << "compiled in " << compile_ms << " ms, " << bytecode.code.size() / 1024 << " KiB of bytecode, "
+              << "stack depth " << bytecode.max_stack_depth << '\n';
+
+    Interpreter interpreter(analyzer);
+    double tree_ms = measure_ms([&]() {
+        for (int i = 0; i < kRepeatCount; ++i)
+        {
+            interpreter.run();
+        }
+    });
+    StackVm vm(&bytecode);
+    double vm_ms = measure_ms([&]() {
+        for (int i = 0; i < kRepeatCount; ++i)
+        {
+            vm.run();
+        }
+    });
+
+    std::cout << "AST:       " << tree_ms / kRepeatCount << " ms, "
+              << kStatementCount * kRepeatCount / tree_ms / 1000 << " Mstatements/s\n";
+    std::cout << "stack VM:  " << vm_ms / kRepeatCount << " ms, " << kStatementCount * kRepeatCount / vm_ms / 1000
+              << " Mstatements/s, " << tree_ms / vm_ms << "x faster\n";
+
+    /// @note Both must agree, and it keeps the runs from being optimized away
+    for (SlotIndex slot = 0; slot < vm.get_variable_count(); ++slot)
+    {
+        Value expected = interpreter.get_value(slot);
+        Value actual = vm.get_value(slot);
+        bool equal = (expected.get_type() == ValueType::INTEGER) ? expected.get_integer() == actual.get_integer()
+                                                                 : expected.get_real() == actual.get_real();
+        if (!equal)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,72 @@
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ast.hpp"
+#include "bench_program.hpp"
+#include "diagnostic.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Validate a batch of small scripts, every other one having a few syntax errors
+int main()
+{
+    constexpr std::size_t kScriptCount = 20000;
+
+    std::vector<std::string> scripts;
+    for (std::size_t i = 0; i < kScriptCount; i++)
+    {
+        std::string script = make_bench_program(20, 4);
+        if (i % 2 == 0)
+        {
+            /// @note Break three statements: a missing operand, a missing separator and a stray token
+            std::size_t begin = script.find("BEGIN");
+            script.replace(script.find(" - 7", begin), 4, " -");
+            script.replace(script.find(";\n", script.find(";\n", begin) + 20), 1, "");
+            script.replace(script.rfind(" * 1.25"), 1, " ) ");
+        }
+        scripts.push_back(std::move(script));
+    }
+
+    std::size_t rejected = 0;
+    double throw_ms = measure_ms([&]() {
+        for (const std::string &script : scripts)
+        {
+            try
+            {
+                Lexer lexer(script);
+                TokenBuffer tokens = lexer.tokenize();
+                delete Parser(&tokens).parse();
+            }
+            catch (const std::runtime_error &)
+            {
+                rejected++;
+            }
+        }
+    });
+    std::cout << map_error_mode_to_string(ErrorMode::THROW) << ": " << throw_ms << " ms, " << rejected
+              << " scripts rejected, one error each\n";
+
+    rejected = 0;
+    std::size_t error_count = 0;
+    double collect_ms = measure_ms([&]() {
+        for (const std::string &script : scripts)
+        {
+            Lexer lexer(script);
+            lexer.set_error_mode(ErrorMode::COLLECT);
+            TokenBuffer tokens = lexer.tokenize();
+            Parser parser(&tokens);
+            parser.set_error_mode(ErrorMode::COLLECT);
+            delete parser.parse();
+
+            error_count += parser.get_diagnostics().size();
+            rejected += parser.get_diagnostics().empty() ? 0 : 1;
+        }
+    });
+    std::cout << map_error_mode_to_string(ErrorMode::COLLECT) << ": " << collect_ms << " ms, " << rejected
+              << " scripts rejected, " << error_count << " errors\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "ast.hpp"
+#include "bench_program.hpp"
+#include "bytecode.hpp"
+#include "dispatch.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "register_vm.hpp"
+#include "semantic_analyzer.hpp"
+#include "stack_vm.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Generate a PROGRAM of *statement_count* assignments of long expressions mixing
+/// every INTEGER and REAL operator, so that run time is mostly instruction dispatch
+static std::string make_arithmetic_program(std::size_t statement_count, std::size_t variable_count = 16)
+{
+    std::string program = "PROGRAM Arithmetic;\nVAR\n";
+    for (std::size_t i = 0; i < variable_count; i++)
+    {
+        program += "    i" + std::to_string(i) + " : INTEGER;\n";
+        program += "    r" + std::to_string(i) + " : REAL;\n";
+    }
+
+    program += "BEGIN\n";
+    for (std::size_t i = 0; i < statement_count; i++)
+    {
+        std::string a = std::to_string(i % variable_count);
+        std::string b = std::to_string((i * 7 + 3) % variable_count);
+        std::string c = std::to_string((i * 13 + 5) % variable_count);
+
+        if (i % 2 == 0)
+        {
+            program += "    i" + a + " := -(i" + b + " + 3) * (i" + c + " - i" + a + ") DIV 7 + i" + b +
+                       " * 5 - (i" + c + " DIV 2 + 1) * 3;\n";
+        }
+        else
+        {
+            program += "    r" + a + " := (r" + b + " * 0.5 - i" + c + ") / 3 + -r" + c + " * 0.25 + (i" + b +
+                       " + 1) / (r" + a + " * r" + a + " + 1.5);\n";
+        }
+    }
+    program += "END.\n";
+
+    return program;
+}
+
+/// @brief Run *vm* *repeat_count* times and print its speed on *statement_count* statements
+template <typename TVm>
+static void run_bench(const char *name, TVm &vm, std::size_t statement_count, int repeat_count)
+{
+    double ms = measure_ms([&]() {
+        for (int i = 0; i < repeat_count; ++i)
+        {
+            vm.run();
+        }
+    });
+    std::cout << "  " << name << ms / repeat_count << " ms, " << statement_count * repeat_count / ms / 1000
+              << " Mstatements/s\n";
+}
+
+/// @brief Statements per second of the *StackVm* and the *RegisterVm* with the dispatch they
+/// were built with, `make bench/dispatch` compares both dispatches
+int main()
+{
+    constexpr std::size_t kStatementCount = 1000000;
+    constexpr int kRepeatCount = 5;
+    std::cout << map_dispatch_to_string(kDispatch) << " dispatch\n";
+
+    struct
+    {
+        const char *name;
+        std::string source;
+    } programs[] = {{"bench program", make_bench_program(kStatementCount)},
+                    {"arithmetic program", make_arithmetic_program(kStatementCount)}};
+
+    for (const auto &program : programs)
+    {
+        Lexer lexer(program.source);
+        TokenBuffer tokens = lexer.tokenize();
+        Parser parser(&tokens);
+        std::unique_ptr<AbstractSyntaxTree> ast(parser.parse());
+        SemanticAnalyzer analyzer(ast.get());
+        if (!analyzer.analyze())
+        {
+            return EXIT_FAILURE;
+        }
+
+        BytecodeProgram bytecode = BytecodeCompiler(analyzer).compile();
+        RegisterProgram registers = RegisterCompiler(analyzer).compile();
+        std::cout << program.name << ":\n";
+        StackVm stack_vm(&bytecode);
+        run_bench("stack VM:     ", stack_vm, kStatementCount, kRepeatCount);
+        RegisterVm register_vm(&registers);
+        run_bench("register VM:  ", register_vm, kStatementCount, kRepeatCount);
+
+        /// @note Both must agree, and it keeps the runs from being optimized away
+        for (SlotIndex slot = 0; slot < register_vm.get_variable_count(); ++slot)
+        {
+            Value expected = stack_vm.get_value(slot);
+            Value actual = register_vm.get_value(slot);
+            bool equal = (expected.get_type() == ValueType::INTEGER) ? expected.get_integer() == actual.get_integer()
+                                                                     : expected.get_real() == actual.get_real();
+            if (!equal)
+            {
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
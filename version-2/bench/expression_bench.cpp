@@ -0,0 +1,90 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "ast.hpp"
+#include "bench_program.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Best of a few parses of *program* with *parsing*, in ms
+static double parse_ms(const std::string &program, ExpressionParsing parsing)
+{
+    constexpr int kRunCount = 3;
+
+    Lexer lexer(program);
+    TokenBuffer tokens = lexer.tokenize();
+    double best_ms = 0;
+    for (int run = 0; run < kRunCount; run++)
+    {
+        double ms = measure_ms([&]() {
+            Parser parser(&tokens);
+            parser.set_expression_parsing(parsing);
+            delete parser.parse();
+        });
+        best_ms = (run == 0 || ms < best_ms) ? ms : best_ms;
+    }
+    return best_ms;
+}
+
+/// @brief PROGRAM assigning *expression* to a variable
+static std::string make_expression_program(const std::string &expression)
+{
+    return "PROGRAM Bench;\nVAR\n    a : INTEGER;\nBEGIN\n    a := " + expression + "\nEND.\n";
+}
+
+static std::string repeat(const std::string &text, std::size_t count)
+{
+    std::string result;
+    result.reserve(text.length() * count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        result += text;
+    }
+    return result;
+}
+
+/// @brief Precedence climbing against recursive descent on typical, long and deeply nested expressions
+int main()
+{
+    /// @note Recursive descent overflows the native stack long before the deep cases
+    /// below, it only runs at a depth it survives
+    constexpr std::size_t kSafeDepth = 5000;
+    constexpr std::size_t kDeepDepth = 1000000;
+
+    struct Case
+    {
+        const char *name;
+        std::string program;
+        bool recursive_survives;
+    };
+    const Case kCases[] = {
+        {"1M typical statements", make_bench_program(1000000), true},
+        {"1M-term chain", make_expression_program(repeat("a * 2 + ", 1000000) + "a"), true},
+        {"5k nested parentheses", make_expression_program(repeat("(", kSafeDepth) + "a" + repeat(")", kSafeDepth)), true},
+        {"5k unary signs", make_expression_program(repeat("- ", kSafeDepth) + "a"), true},
+        {"1M nested parentheses", make_expression_program(repeat("(", kDeepDepth) + "a" + repeat(")", kDeepDepth)), false},
+        {"1M unary signs", make_expression_program(repeat("- ", kDeepDepth) + "a"), false},
+    };
+
+    for (const Case &bench_case : kCases)
+    {
+        double climbing_ms = parse_ms(bench_case.program, ExpressionParsing::PRECEDENCE_CLIMBING);
+        std::cout << bench_case.name << ": " << map_expression_parsing_to_string(ExpressionParsing::PRECEDENCE_CLIMBING)
+                  << " " << climbing_ms << " ms";
+        if (bench_case.recursive_survives)
+        {
+            double recursive_ms = parse_ms(bench_case.program, ExpressionParsing::RECURSIVE_DESCENT);
+            std::cout << ", " << map_expression_parsing_to_string(ExpressionParsing::RECURSIVE_DESCENT) << " "
+                      << recursive_ms << " ms, " << recursive_ms / climbing_ms << "x";
+        }
+        else
+        {
+            std::cout << ", " << map_expression_parsing_to_string(ExpressionParsing::RECURSIVE_DESCENT)
+                      << " would overflow the stack";
+        }
+        std::cout << '\n';
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "ast.hpp"
+#include "ast_node.hpp"
+#include "ast_visitor.hpp"
+#include "bench_program.hpp"
+#include "flat_ast.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Sum of the integer literals of the pointer-based tree, walked recursively
+class LiteralSum : public AstVisitor<LiteralSum>
+{
+public:
+    long long sum = 0;
+
+    void visit_int_num(IntNumNode *node) { sum += node->get_token()->get_value(); }
+};
+
+/// @brief Same sum over the flat tree, a linear scan of the node kinds
+static long long sum_literals(const FlatAst &ast)
+{
+    long long sum = 0;
+    for (NodeIndex node = 0; node < ast.get_node_count(); ++node)
+    {
+        if (ast.get_kind(node) == AstNodeType::INT_NUM)
+        {
+            sum += ast.get_int_value(node);
+        }
+    }
+    return sum;
+}
+
+/// @brief Footprint and traversal time of the pointer-based and the flat AST
+int main()
+{
+    constexpr std::size_t kStatementCount = 1000000;
+    constexpr int kRepeatCount = 10;
+    std::string program = make_bench_program(kStatementCount);
+    Lexer lexer(program);
+    TokenBuffer tokens = lexer.tokenize();
+    Parser parser(&tokens);
+    AbstractSyntaxTree *ast = parser.parse();
+
+    FlatAst *flat_ast = nullptr;
+    double convert_ms = measure_ms([&]() { flat_ast = new FlatAst(ast); });
+
+    std::size_t tree_bytes = ast->get_arena().get_allocated_bytes();
+    std::size_t flat_bytes = flat_ast->get_footprint();
+    std::cout << flat_ast->get_node_count() << " nodes, converted in " << convert_ms << " ms\n";
+    std::cout << "pointer tree: " << tree_bytes / 1024 << " KiB, flat: " << flat_bytes / 1024 << " KiB, "
+              << static_cast<double>(tree_bytes) / flat_bytes << "x smaller\n";
+    std::cout << "source positions: " << flat_ast->get_positions().get_footprint() * 8.0 / flat_ast->get_node_count()
+              << " bits per node\n";
+
+    long long tree_sum = 0;
+    double tree_ms = measure_ms([&]() {
+        for (int i = 0; i < kRepeatCount; ++i)
+        {
+            LiteralSum literal_sum;
+            literal_sum.visit(ast->get_root());
+            tree_sum += literal_sum.sum;
+        }
+    });
+    long long flat_sum = 0;
+    double flat_ms = measure_ms([&]() {
+        for (int i = 0; i < kRepeatCount; ++i)
+        {
+            flat_sum += sum_literals(*flat_ast);
+        }
+    });
+
+    std::cout << "sum of literals, pointer tree: " << tree_ms / kRepeatCount << " ms, flat: "
+              << flat_ms / kRepeatCount << " ms, " << tree_ms / flat_ms << "x faster"
+              << (tree_sum == flat_sum ? "" : " (MISMATCH)") << "\n";
+
+    delete flat_ast;
+    delete ast;
+    return EXIT_SUCCESS;
+}
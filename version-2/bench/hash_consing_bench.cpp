@@ -0,0 +1,45 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "ast.hpp"
+#include "bench_program.hpp"
+#include "flat_ast.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Number of expression nodes, i.e. the evaluation work of a forward scan
+static std::size_t count_expression_nodes(const FlatAst &ast)
+{
+    std::size_t count = 0;
+    for (NodeIndex node = 0; node < ast.get_node_count(); ++node)
+    {
+        AstNodeType kind = ast.get_kind(node);
+        count += kind == AstNodeType::BINARY_OPERATOR || kind == AstNodeType::UNARY_OPERATOR ||
+                 kind == AstNodeType::INT_NUM || kind == AstNodeType::REAL_NUM;
+    }
+    return count;
+}
+
+/// @brief Size and flattening time of the tree and DAG layouts of a *FlatAst*
+int main()
+{
+    constexpr std::size_t kStatementCount = 1000000;
+    std::string program = make_bench_program(kStatementCount);
+    Lexer lexer(program);
+    TokenBuffer tokens = lexer.tokenize();
+    Parser parser(&tokens);
+    std::unique_ptr<AbstractSyntaxTree> ast(parser.parse());
+
+    for (FlatAstLayout layout : {FlatAstLayout::TREE, FlatAstLayout::DAG})
+    {
+        std::unique_ptr<FlatAst> flat_ast;
+        double flatten_ms = measure_ms([&]() { flat_ast.reset(new FlatAst(ast.get(), layout)); });
+        std::cout << map_flat_ast_layout_to_string(layout) << ": " << flat_ast->get_node_count() << " nodes ("
+                  << count_expression_nodes(*flat_ast) << " operators and literals), "
+                  << flat_ast->get_footprint() / 1024 << " KiB, flattened in " << flatten_ms << " ms\n";
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,63 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "ast.hpp"
+#include "bench_program.hpp"
+#include "incremental.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Per-keystroke latency of *IncrementalDocument* on a 100k-line program,
+/// against tokenizing and parsing the whole program again
+int main()
+{
+    constexpr std::size_t kStatementCount = 100000;
+    constexpr int kKeystrokeCount = 200;
+    std::string program = make_bench_program(kStatementCount);
+    std::cout << "source: " << kStatementCount << " lines, " << program.length() / 1024 << " KiB\n";
+
+    IncrementalDocument document(program);
+
+    /// @note Type digits into an integer literal of a statement in the middle,
+    /// then into a comment, then spaces between tokens
+    std::size_t literal = program.find("* 12", program.length() / 2) + 4;
+    double typing_ms = measure_ms([&]() {
+        for (int i = 0; i < kKeystrokeCount; ++i)
+        {
+            document.edit(literal, 0, "7");
+        }
+    });
+    std::size_t comment = program.find(";\n", program.length() / 3) + 1;
+    document.edit(comment, 0, "{}");
+    double comment_ms = measure_ms([&]() {
+        for (int i = 0; i < kKeystrokeCount; ++i)
+        {
+            document.edit(comment + 1, 0, "c");
+        }
+    });
+    double space_ms = measure_ms([&]() {
+        for (int i = 0; i < kKeystrokeCount; ++i)
+        {
+            document.edit(literal - 2, 0, " ");
+        }
+    });
+
+    std::string source = document.get_source();
+    double full_ms = measure_ms([&]() {
+        Lexer lexer(source);
+        TokenBuffer tokens = lexer.tokenize();
+        Parser parser(&tokens);
+        delete parser.parse();
+    });
+
+    std::cout << "full re-lex + re-parse: " << full_ms << " ms\n";
+    std::cout << "incremental, typing in a literal: " << typing_ms / kKeystrokeCount << " ms/keystroke, "
+              << full_ms * kKeystrokeCount / typing_ms << "x faster\n";
+    std::cout << "incremental, typing in a comment: " << comment_ms / kKeystrokeCount << " ms/keystroke, "
+              << full_ms * kKeystrokeCount / comment_ms << "x faster\n";
+    std::cout << "incremental, typing spaces: " << space_ms / kKeystrokeCount << " ms/keystroke, "
+              << full_ms * kKeystrokeCount / space_ms << "x faster\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,39 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "ast.hpp"
+#include "bench_program.hpp"
+#include "interpreter.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "semantic_analyzer.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Statements per second of the *Interpreter*, analysis excluded
+int main()
+{
+    constexpr std::size_t kStatementCount = 1000000;
+    constexpr int kRepeatCount = 5;
+    std::string program = make_bench_program(kStatementCount);
+    Lexer lexer(program);
+    TokenBuffer tokens = lexer.tokenize();
+    Parser parser(&tokens);
+    std::unique_ptr<AbstractSyntaxTree> ast(parser.parse());
+
+    SemanticAnalyzer analyzer(ast.get());
+    double analyze_ms = measure_ms([&]() { analyzer.analyze(); });
+    Interpreter interpreter(analyzer);
+    double run_ms = measure_ms([&]() {
+        for (int i = 0; i < kRepeatCount; ++i)
+        {
+            interpreter.run();
+        }
+    });
+
+    std::cout << interpreter.get_variable_count() << " variables, analyzed in " << analyze_ms << " ms\n";
+    std::cout << "run: " << run_ms / kRepeatCount << " ms, " << kStatementCount * kRepeatCount / run_ms / 1000
+              << " Mstatements/s\n";
+
+    return EXIT_SUCCESS;
+}
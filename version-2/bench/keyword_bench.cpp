@@ -0,0 +1,74 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "keyword.hpp"
+#include "token.hpp"
+
+/// @brief Keyword lookup as Lexer::id() used to do it: build a std::string, hash it, copy the Token
+static const std::unordered_map<std::string, Token> kReversedKeywordTokenMap = {
+    {"BEGIN", Token(TokenType::BEGIN)},
+    {"END", Token(TokenType::END)},
+    {"PROGRAM", Token(TokenType::PROGRAM)},
+    {"VAR", Token(TokenType::VAR)},
+    {"INTEGER", Token(TokenType::INTEGER)},
+    {"REAL", Token(TokenType::REAL)},
+    {"DIV", Token(TokenType::INTEGER_DIV)}};
+
+static TokenType lookup_keyword_with_map(const char *lexeme, std::size_t length)
+{
+    std::string result(lexeme, length);
+    auto it = kReversedKeywordTokenMap.find(result);
+    return (it != kReversedKeywordTokenMap.end()) ? Token(it->second).get_type() : TokenType::ID;
+}
+
+/// @brief Identifier-heavy input: mostly variable names, some keywords
+static std::vector<std::string> make_lexemes(std::size_t count)
+{
+    static const char *kSamples[] = {
+        "a", "b", "counter", "total2", "BEGIN", "END", "x", "value",
+        "DIV", "tmp", "y", "alpha", "REAL", "INTEGER", "beta", "ENDING",
+        "VAR", "PROGRAM", "result", "i", "REALLY", "index", "sum", "Divide"};
+    constexpr std::size_t kSampleCount = sizeof(kSamples) / sizeof(kSamples[0]);
+
+    std::vector<std::string> lexemes;
+    lexemes.reserve(count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        lexemes.push_back(kSamples[(i * 7 + i / kSampleCount) % kSampleCount]);
+    }
+    return lexemes;
+}
+
+template <typename TLookup>
+static double measure(const std::vector<std::string> &lexemes, TLookup lookup, std::size_t &keyword_count)
+{
+    auto start = std::chrono::steady_clock::now();
+    keyword_count = 0;
+    for (const std::string &lexeme : lexemes)
+    {
+        keyword_count += lookup(lexeme.data(), lexeme.length()) != TokenType::ID ? 1 : 0;
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    constexpr std::size_t kLexemeCount = 10000000;
+    std::vector<std::string> lexemes = make_lexemes(kLexemeCount);
+
+    std::size_t map_keywords = 0;
+    std::size_t hash_keywords = 0;
+    double map_ms = measure(lexemes, lookup_keyword_with_map, map_keywords);
+    double hash_ms = measure(lexemes, lookup_keyword, hash_keywords);
+
+    std::cout << "lexemes:            " << kLexemeCount << '\n'
+              << "unordered_map:      " << map_ms << " ms (" << map_keywords << " keywords)\n"
+              << "perfect hash:       " << hash_ms << " ms (" << hash_keywords << " keywords)\n"
+              << "speedup:            " << map_ms / hash_ms << "x\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,43 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "bench_program.hpp"
+#include "char_scan.hpp"
+#include "lexer.hpp"
+#include "source.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Tokenize comment-heavy generated code with every scanning backend
+int main()
+{
+    constexpr std::size_t kStatementCount = 100000;
+    constexpr std::size_t kCommentLength = 400;
+    std::string program = make_bench_program(kStatementCount, 64, kCommentLength);
+    SourceView source(program.data(), program.length());
+
+    std::cout << "source: " << program.length() / (1024 * 1024) << " MiB\n";
+
+    const ScanBackend kBackends[] = {ScanBackend::SCALAR, ScanBackend::SSE2, ScanBackend::AVX2};
+    double scalar_ms = 0;
+    for (ScanBackend backend : kBackends)
+    {
+        set_scan_backend(backend);
+        if (get_scan_backend() != backend)
+        {
+            std::cout << map_scan_backend_to_string(backend) << ": not supported\n";
+            continue;
+        }
+
+        std::size_t token_count = 0;
+        double ms = measure_ms([&]() {
+            Lexer lexer(source);
+            token_count = lexer.tokenize().size();
+        });
+        scalar_ms = (backend == ScanBackend::SCALAR) ? ms : scalar_ms;
+
+        std::cout << map_scan_backend_to_string(backend) << ": " << ms << " ms, "
+                  << token_count << " tokens, " << scalar_ms / ms << "x vs SCALAR\n";
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,46 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "bench_program.hpp"
+#include "lexer.hpp"
+#include "parallel_lexer.hpp"
+#include "source.hpp"
+#include "thread_pool.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Tokens per second of *ParallelLexer* for a growing number of threads,
+/// *Lexer::tokenize()* being the sequential baseline
+int main()
+{
+    constexpr std::size_t kStatementCount = 1000000;
+    constexpr std::size_t kCommentLength = 24;
+    std::string program = make_bench_program(kStatementCount, 64, kCommentLength);
+    SourceView source(program.data(), program.length());
+
+    std::cout << "source: " << program.length() / (1024 * 1024) << " MiB\n";
+
+    std::size_t token_count = 0;
+    double sequential_ms = measure_ms([&]() {
+        Lexer lexer(source);
+        token_count = lexer.tokenize().size();
+    });
+    std::cout << "sequential: " << sequential_ms << " ms, "
+              << token_count / sequential_ms / 1000 << " Mtokens/s\n";
+
+    std::size_t max_thread_count = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+    {
+        ThreadPool pool(thread_count);
+        double ms = measure_ms([&]() {
+            ParallelLexer lexer(source, &pool);
+            token_count = lexer.tokenize().size();
+        });
+
+        std::cout << thread_count << " thread(s): " << ms << " ms, "
+                  << token_count / ms / 1000 << " Mtokens/s, "
+                  << sequential_ms / ms << "x vs sequential\n";
+    }
+
+    return EXIT_SUCCESS;
+}
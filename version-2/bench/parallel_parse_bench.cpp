@@ -0,0 +1,50 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "ast.hpp"
+#include "bench_program.hpp"
+#include "lexer.hpp"
+#include "parallel_parser.hpp"
+#include "parser.hpp"
+#include "thread_pool.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Statements per second of *ParallelParser* for a growing number of threads,
+/// *Parser::parse()* being the sequential baseline
+int main()
+{
+    constexpr std::size_t kStatementCount = 1000000;
+    std::string program = make_bench_program(kStatementCount);
+    Lexer lexer(program);
+    TokenBuffer tokens = lexer.tokenize();
+
+    std::cout << "tokens: " << tokens.size() << '\n';
+
+    /// @note Warm up the allocator, the first parse pays for fresh pages
+    delete Parser(&tokens).parse();
+
+    double sequential_ms = measure_ms([&]() {
+        Parser parser(&tokens);
+        delete parser.parse();
+    });
+    std::cout << "sequential: " << sequential_ms << " ms, "
+              << kStatementCount / sequential_ms / 1000 << " Mstatements/s\n";
+
+    std::size_t max_thread_count = std::max(16u, std::thread::hardware_concurrency());
+    for (std::size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+    {
+        ThreadPool pool(thread_count);
+        double ms = measure_ms([&]() {
+            ParallelParser parser(&tokens, &pool);
+            delete parser.parse();
+        });
+
+        std::cout << thread_count << " thread(s): " << ms << " ms, "
+                  << kStatementCount / ms / 1000 << " Mstatements/s, "
+                  << sequential_ms / ms << "x vs sequential\n";
+    }
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << '\n';
+
+    return EXIT_SUCCESS;
+}
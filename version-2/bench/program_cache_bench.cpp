@@ -0,0 +1,72 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bench_program.hpp"
+#include "program_cache.hpp"
+
+/// @brief Submissions per second of a small set of scripts submitted over and over by
+/// several threads, compiled every time versus served by a *ProgramCache*, each submission
+/// running its program
+int main()
+{
+    constexpr std::size_t kScriptCount = 8;
+    constexpr std::size_t kStatementCount = 2000;
+    constexpr std::size_t kThreadCount = 4;
+    constexpr std::size_t kSubmissionCount = 2000;
+
+    std::vector<std::string> scripts;
+    for (std::size_t i = 0; i < kScriptCount; i++)
+    {
+        scripts.push_back(make_bench_program(kStatementCount + i));
+    }
+
+    /// @brief Run kSubmissionCount submissions spread over kThreadCount threads
+    auto submit_all = [&](ProgramCache *cache) {
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < kThreadCount; t++)
+        {
+            threads.emplace_back([&, t]() {
+                for (std::size_t i = t; i < kSubmissionCount; i += kThreadCount)
+                {
+                    const std::string &script = scripts[(i * 5) % kScriptCount];
+                    SourceView source(script.data(), script.length());
+                    std::shared_ptr<const CompiledProgram> program =
+                        (cache != nullptr) ? cache->get(source) : std::make_shared<CompiledProgram>(source);
+                    RegisterVm vm(&program->get_program());
+                    vm.run();
+                    if (vm.get_variable_count() == 0)
+                    {
+                        std::abort();
+                    }
+                }
+            });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    };
+
+    double uncached_ms = measure_ms([&]() { submit_all(nullptr); });
+    std::cout << "uncached: " << uncached_ms << " ms, " << kSubmissionCount / uncached_ms * 1000 << " submissions/s\n";
+
+    ProgramCache cache;
+    double cached_ms = measure_ms([&]() { submit_all(&cache); });
+    ProgramCacheStats stats = cache.get_stats();
+    std::cout << "cached:   " << cached_ms << " ms, " << kSubmissionCount / cached_ms * 1000 << " submissions/s, "
+              << uncached_ms / cached_ms << "x faster\n";
+    std::cout << "  " << stats.hits << " hits, " << stats.misses << " misses, " << stats.entry_count << " programs, "
+              << stats.bytes / 1024 << " KiB\n";
+
+    /// @note Room for half of the scripts only
+    ProgramCache small_cache(stats.bytes / 2);
+    double small_ms = measure_ms([&]() { submit_all(&small_cache); });
+    ProgramCacheStats small_stats = small_cache.get_stats();
+    std::cout << "cached, half capacity: " << small_ms << " ms, " << small_stats.hits << " hits, "
+              << small_stats.misses << " misses, " << small_stats.evictions << " evictions\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "ast.hpp"
+#include "bench_program.hpp"
+#include "bytecode.hpp"
+#include "interpreter.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "register_vm.hpp"
+#include "semantic_analyzer.hpp"
+#include "stack_vm.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Number of instructions of *program*, operands excluded
+static std::size_t count_instructions(const BytecodeProgram &program)
+{
+    std::size_t count = 0;
+    for (std::size_t offset = 0; offset < program.code.size(); ++count)
+    {
+        Opcode opcode = static_cast<Opcode>(program.code[offset]);
+        offset += 1 + (has_operand(opcode) ? 4 : 0);
+    }
+    return count;
+}
+
+/// @brief Instructions dispatched per statement and statements per second of the tree-walking
+/// *Interpreter*, of the *StackVm* and of the *RegisterVm* running the same analyzed program
+int main()
+{
+    constexpr std::size_t kStatementCount = 1000000;
+    constexpr int kRepeatCount = 5;
+    std::string program = make_bench_program(kStatementCount);
+    Lexer lexer(program);
+    TokenBuffer tokens = lexer.tokenize();
+    Parser parser(&tokens);
+    std::unique_ptr<AbstractSyntaxTree> ast(parser.parse());
+    SemanticAnalyzer analyzer(ast.get());
+    analyzer.analyze();
+
+    BytecodeProgram bytecode = BytecodeCompiler(analyzer).compile();
+    RegisterProgram registers;
+    double compile_ms = measure_ms([&]() { registers = RegisterCompiler(analyzer).compile(); });
+    std::cout << "register allocation in " << compile_ms << " ms, " << registers.constants.size() << " constants, "
+              << registers.temporary_count << " temporaries\n";
+    std::cout << "stack VM:     " << static_cast<double>(count_instructions(bytecode)) / kStatementCount
+              << " instructions/statement\n";
+    std::cout << "register VM:  " << static_cast<double>(registers.code.size()) / kStatementCount
+              << " instructions/statement\n";
+
+    Interpreter interpreter(analyzer);
+    double tree_ms = measure_ms([&]() {
+        for (int i = 0; i < kRepeatCount; ++i)
+        {
+            interpreter.run();
+        }
+    });
+    StackVm stack_vm(&bytecode);
+    double stack_ms = measure_ms([&]() {
+        for (int i = 0; i < kRepeatCount; ++i)
+        {
+            stack_vm.run();
+        }
+    });
+    RegisterVm register_vm(&registers);
+    double register_ms = measure_ms([&]() {
+        for (int i = 0; i < kRepeatCount; ++i)
+        {
+            register_vm.run();
+        }
+    });
+
+    std::cout << "AST:          " << tree_ms / kRepeatCount << " ms, "
+              << kStatementCount * kRepeatCount / tree_ms / 1000 << " Mstatements/s\n";
+    std::cout << "stack VM:     " << stack_ms / kRepeatCount << " ms, "
+              << kStatementCount * kRepeatCount / stack_ms / 1000 << " Mstatements/s\n";
+    std::cout << "register VM:  " << register_ms / kRepeatCount << " ms, "
+              << kStatementCount * kRepeatCount / register_ms / 1000 << " Mstatements/s, "
+              << stack_ms / register_ms << "x faster than the stack VM\n";
+
+    /// @note All must agree, and it keeps the runs from being optimized away
+    for (SlotIndex slot = 0; slot < register_vm.get_variable_count(); ++slot)
+    {
+        Value expected = interpreter.get_value(slot);
+        for (Value actual : {stack_vm.get_value(slot), register_vm.get_value(slot)})
+        {
+            bool equal = (expected.get_type() == ValueType::INTEGER) ? expected.get_integer() == actual.get_integer()
+                                                                     : expected.get_real() == actual.get_real();
+            if (!equal)
+            {
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
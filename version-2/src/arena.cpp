@@ -0,0 +1,30 @@
+#include "arena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+constexpr std::size_t Arena::kDefaultBlockSize;
+
+Arena::Arena(std::size_t first_block_size) : next_block_size_{first_block_size} {}
+
+void *Arena::allocate(std::size_t size, std::size_t alignment)
+{
+    std::uintptr_t cursor = reinterpret_cast<std::uintptr_t>(cursor_);
+    std::uintptr_t aligned = (cursor + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    if (cursor_ == nullptr || aligned + size > reinterpret_cast<std::uintptr_t>(limit_))
+    {
+        /// @note An oversized request still gets a block of its own
+        std::size_t block_size = std::max(next_block_size_, size + alignment);
+        blocks_.emplace_back(new char[block_size]);
+        cursor_ = blocks_.back().get();
+        limit_ = cursor_ + block_size;
+        reserved_bytes_ += block_size;
+        next_block_size_ *= 2;
+
+        cursor = reinterpret_cast<std::uintptr_t>(cursor_);
+        aligned = (cursor + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    }
+
+    cursor_ = reinterpret_cast<char *>(aligned + size);
+    allocated_bytes_ += size;
+    return reinterpret_cast<void *>(aligned);
+}
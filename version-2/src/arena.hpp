@@ -0,0 +1,59 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/// @brief Bump allocator: objects are carved one after the other from large blocks,
+/// and all of them are released at once when the arena is destroyed.
+/// @note Blocks double in size, so a program of n nodes needs O(log n) blocks and
+/// releasing them does not depend on the number of objects.
+/// @warning Destructors of the created objects are never run, only create objects
+/// that do not own resources outside of the arena.
+class Arena
+{
+public:
+    static constexpr std::size_t kDefaultBlockSize = 64 * 1024;
+
+    explicit Arena(std::size_t first_block_size = kDefaultBlockSize);
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /// @brief Uninitialized memory for *size* bytes aligned on *alignment*
+    void *allocate(std::size_t size, std::size_t alignment);
+
+    /// @brief Construct a *TObject* in the arena
+    template <typename TObject, typename... TArgs>
+    TObject *create(TArgs &&...args)
+    {
+        return new (allocate(sizeof(TObject), alignof(TObject))) TObject(std::forward<TArgs>(args)...);
+    }
+
+    /// @brief Copy *count* trivially copyable elements into the arena
+    template <typename TElement>
+    TElement *copy_array(const TElement *elements, std::size_t count)
+    {
+        TElement *copy = static_cast<TElement *>(allocate(sizeof(TElement) * count, alignof(TElement)));
+        std::uninitialized_copy(elements, elements + count, copy);
+        return copy;
+    }
+
+    /// @brief Bytes handed out so far
+    std::size_t get_allocated_bytes() const noexcept { return allocated_bytes_; }
+    /// @brief Bytes of every block, including their unused tails
+    std::size_t get_reserved_bytes() const noexcept { return reserved_bytes_; }
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char *cursor_ = nullptr;
+    char *limit_ = nullptr;
+    std::size_t next_block_size_;
+    std::size_t allocated_bytes_ = 0;
+    std::size_t reserved_bytes_ = 0;
+};
+
+#endif
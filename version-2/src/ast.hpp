@@ -1,20 +1,40 @@
 #ifndef AST_HPP
 #define AST_HPP
 
+#include <memory>
+#include <vector>
+#include "arena.hpp"
 #include "ast_node.hpp"
+#include "interner.hpp"
 
 /// @brief Abstract syntax tree
+/// @note Every node (and token, and list of children) lives in the arena of the tree,
+/// destroying the tree releases a handful of blocks instead of walking every node.
 class AbstractSyntaxTree
 {
 public:
-    explicit AbstractSyntaxTree(ProgramNode *root);
-    ~AbstractSyntaxTree();
+    /// @note The tree is empty until *set_root()*, nodes are created in *get_arena()* first
+    explicit AbstractSyntaxTree(std::shared_ptr<Interner> interner);
+
+    AbstractSyntaxTree(const AbstractSyntaxTree &) = delete;
+    AbstractSyntaxTree &operator=(const AbstractSyntaxTree &) = delete;
 
     /// @brief Root node
     ProgramNode *get_root();
+    void set_root(ProgramNode *root) noexcept;
+    /// @brief Arena owning every node of the tree
+    Arena &get_arena() noexcept;
+    /// @brief Keep *arena* alive as long as the tree, for subtrees built in another arena
+    /// (e.g. on another thread)
+    void adopt_arena(std::unique_ptr<Arena> arena);
+    /// @brief Interner resolving the symbols of *VariableNode* and *ProgramNode*
+    const std::shared_ptr<Interner> &get_interner() const noexcept;
 
 private:
-    ProgramNode *root_;
+    Arena arena_;
+    std::vector<std::unique_ptr<Arena>> adopted_arenas_;
+    ProgramNode *root_ = nullptr;
+    std::shared_ptr<Interner> interner_;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,350 @@
+#include "ast_file.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+#include "ast_node.hpp"
+#include "interner.hpp"
+#include "position_table.hpp"
+#include "source.hpp"
+#include "token.hpp"
+
+static_assert(sizeof(AstNodeType) == 1 && sizeof(TokenType) == 1, "Node kinds and operators are stored as bytes");
+
+static const char kAstFileMagic[8] = {'P', 'A', 'S', 'C', 'A', 'S', 'T', '\0'};
+/// @brief Reads back as another value on a machine of the other byte order
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+namespace
+{
+    struct AstFileHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order_mark;
+        std::uint32_t node_count;
+        std::uint32_t child_count;
+        std::uint32_t real_count;
+        std::uint32_t name_count;
+        std::uint32_t name_byte_count;
+        std::uint32_t position_byte_count;
+        std::uint32_t checkpoint_count;
+        std::uint32_t reserved;
+    };
+
+    /// @brief Offset of every array in the file, derived from the counts of the header
+    struct AstFileLayout
+    {
+        std::size_t reals;
+        std::size_t firsts;
+        std::size_t seconds;
+        std::size_t children;
+        std::size_t name_offsets;
+        std::size_t checkpoints;
+        std::size_t kinds;
+        std::size_t operators;
+        std::size_t names;
+        std::size_t positions;
+        std::size_t size;
+    };
+
+    std::size_t align(std::size_t offset) noexcept { return (offset + 7) & ~static_cast<std::size_t>(7); }
+
+    AstFileLayout compute_layout(const AstFileHeader &header) noexcept
+    {
+        AstFileLayout layout;
+        layout.reals = align(sizeof(AstFileHeader));
+        layout.firsts = align(layout.reals + header.real_count * sizeof(double));
+        layout.seconds = align(layout.firsts + header.node_count * sizeof(std::uint32_t));
+        layout.children = align(layout.seconds + header.node_count * sizeof(std::uint32_t));
+        layout.name_offsets = align(layout.children + header.child_count * sizeof(NodeIndex));
+        layout.checkpoints = align(layout.name_offsets + (header.name_count + 1) * sizeof(std::uint32_t));
+        layout.kinds = align(layout.checkpoints + header.checkpoint_count * 2 * sizeof(std::uint32_t));
+        layout.operators = align(layout.kinds + header.node_count * sizeof(AstNodeType));
+        layout.names = align(layout.operators + header.node_count * sizeof(TokenType));
+        layout.positions = align(layout.names + header.name_byte_count);
+        layout.size = layout.positions + header.position_byte_count;
+        return layout;
+    }
+
+    bool is_expression(AstNodeType kind) noexcept
+    {
+        return kind == AstNodeType::BINARY_OPERATOR || kind == AstNodeType::UNARY_OPERATOR ||
+               kind == AstNodeType::VARIABLE || kind == AstNodeType::INT_NUM || kind == AstNodeType::REAL_NUM ||
+               kind == AstNodeType::ERROR;
+    }
+
+    bool is_statement(AstNodeType kind) noexcept
+    {
+        return kind == AstNodeType::COMPOUND_STATEMENT || kind == AstNodeType::ASSIGNMENT_STATEMENT ||
+               kind == AstNodeType::NO_OPERATION || kind == AstNodeType::ERROR;
+    }
+
+    /// @brief Append *count* elements at *offset* of the file, zero-padding up to it
+    template <typename TElement>
+    void write_array(std::ofstream &output, std::size_t offset, const TElement *elements, std::size_t count)
+    {
+        static const char kPadding[8] = {};
+        output.write(kPadding, static_cast<std::streamsize>(offset - static_cast<std::size_t>(output.tellp())));
+        output.write(reinterpret_cast<const char *>(elements), static_cast<std::streamsize>(count * sizeof(TElement)));
+    }
+}
+
+void AstFile::save(const FlatAst &ast, const std::string &path)
+{
+    const Interner &interner = *ast.get_interner();
+    std::vector<std::uint32_t> name_offsets = {0};
+    std::string names;
+    for (SymbolId symbol = 0; symbol < interner.size(); ++symbol)
+    {
+        SourceView name = interner.get_name(symbol);
+        names.append(name.data(), name.length());
+        name_offsets.push_back(static_cast<std::uint32_t>(names.length()));
+    }
+
+    const FlatAst::Columns &columns = ast.columns_;
+    const PositionTable &positions = ast.positions_;
+
+    AstFileHeader header;
+    std::memcpy(header.magic, kAstFileMagic, sizeof(kAstFileMagic));
+    header.version = kAstFileVersion;
+    header.byte_order_mark = kByteOrderMark;
+    header.node_count = static_cast<std::uint32_t>(columns.node_count);
+    header.child_count = static_cast<std::uint32_t>(columns.child_count);
+    header.real_count = static_cast<std::uint32_t>(columns.real_count);
+    header.name_count = static_cast<std::uint32_t>(interner.size());
+    header.name_byte_count = static_cast<std::uint32_t>(names.length());
+    header.position_byte_count = static_cast<std::uint32_t>(positions.bytes_.size());
+    header.checkpoint_count = static_cast<std::uint32_t>(positions.checkpoints_.size());
+    header.reserved = 0;
+    AstFileLayout layout = compute_layout(header);
+
+    /// @note Written aside then renamed over *path*, so that an interrupted save never
+    /// leaves a truncated file where a complete one is expected
+    std::string temporary_path = path + ".tmp" + std::to_string(getpid());
+    std::ofstream output(temporary_path, std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    write_array(output, layout.reals, columns.reals, columns.real_count);
+    write_array(output, layout.firsts, columns.firsts, columns.node_count);
+    write_array(output, layout.seconds, columns.seconds, columns.node_count);
+    write_array(output, layout.children, columns.children, columns.child_count);
+    write_array(output, layout.name_offsets, name_offsets.data(), name_offsets.size());
+    write_array(output, layout.checkpoints, positions.checkpoints_.data(), positions.checkpoints_.size());
+    write_array(output, layout.kinds, columns.kinds, columns.node_count);
+    write_array(output, layout.operators, columns.operators, columns.node_count);
+    write_array(output, layout.names, names.data(), names.length());
+    write_array(output, layout.positions, positions.bytes_.data(), positions.bytes_.size());
+
+    output.close();
+    if (!output || std::rename(temporary_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporary_path.c_str());
+        __THROW_SAVING_AST_ERROR
+    }
+}
+
+bool AstFile::is_valid_tree(const FlatAst &ast, std::size_t name_count) noexcept
+{
+    const FlatAst::Columns &columns = ast.columns_;
+    auto is_node = [&](std::uint32_t node, NodeIndex user) { return node < user; };
+    auto is_symbol = [&](std::uint32_t symbol) { return symbol < name_count || symbol == kInvalidSymbol; };
+    auto has_kind = [&](std::uint32_t node, NodeIndex user, AstNodeType kind) {
+        return is_node(node, user) && columns.kinds[node] == kind;
+    };
+
+    for (NodeIndex node = 0; node < columns.node_count; ++node)
+    {
+        std::uint32_t first = columns.firsts[node];
+        std::uint32_t second = columns.seconds[node];
+        TokenType op = columns.operators[node];
+        bool is_valid;
+        switch (columns.kinds[node])
+        {
+        case AstNodeType::PROGRAM:
+            is_valid = node == columns.node_count - 1 && has_kind(first, node, AstNodeType::BLOCK) && is_symbol(second);
+            break;
+        case AstNodeType::BLOCK:
+        case AstNodeType::COMPOUND_STATEMENT:
+        {
+            is_valid = static_cast<std::uint64_t>(first) + second <= columns.child_count;
+            for (std::uint32_t i = 0; is_valid && i < second; ++i)
+            {
+                NodeIndex child = columns.children[first + i];
+                if (columns.kinds[node] == AstNodeType::COMPOUND_STATEMENT)
+                {
+                    is_valid = is_node(child, node) && is_statement(columns.kinds[child]);
+                }
+                else
+                {
+                    /// @note Declarations, then the compound statement
+                    is_valid = has_kind(child, node, (i + 1 < second) ? AstNodeType::VARIABLE_DECLARATION
+                                                                      : AstNodeType::COMPOUND_STATEMENT);
+                }
+            }
+            is_valid = is_valid && (columns.kinds[node] == AstNodeType::COMPOUND_STATEMENT || second > 0);
+            break;
+        }
+        case AstNodeType::VARIABLE_DECLARATION:
+            is_valid = has_kind(first, node, AstNodeType::VARIABLE) && has_kind(second, node, AstNodeType::TYPE);
+            break;
+        case AstNodeType::ASSIGNMENT_STATEMENT:
+            is_valid = has_kind(first, node, AstNodeType::VARIABLE) && is_node(second, node) &&
+                       is_expression(columns.kinds[second]);
+            break;
+        case AstNodeType::BINARY_OPERATOR:
+            is_valid = is_node(first, node) && is_expression(columns.kinds[first]) && is_node(second, node) &&
+                       is_expression(columns.kinds[second]) &&
+                       (op == TokenType::PLUS || op == TokenType::MINUS || op == TokenType::MUL ||
+                        op == TokenType::FLOAT_DIV || op == TokenType::INTEGER_DIV);
+            break;
+        case AstNodeType::UNARY_OPERATOR:
+            is_valid = is_node(first, node) && is_expression(columns.kinds[first]) &&
+                       (op == TokenType::PLUS || op == TokenType::MINUS);
+            break;
+        case AstNodeType::VARIABLE:
+            is_valid = is_symbol(first);
+            break;
+        case AstNodeType::TYPE:
+            is_valid = op == TokenType::INTEGER || op == TokenType::REAL;
+            break;
+        case AstNodeType::REAL_NUM:
+            is_valid = first < columns.real_count;
+            break;
+        case AstNodeType::INT_NUM:
+        case AstNodeType::NO_OPERATION:
+        case AstNodeType::ERROR:
+            is_valid = true;
+            break;
+        default:
+            is_valid = false;
+            break;
+        }
+
+        if (!is_valid)
+        {
+            return false;
+        }
+    }
+    return columns.kinds[columns.node_count - 1] == AstNodeType::PROGRAM;
+}
+
+bool AstFile::is_valid_position_table(const PositionTable &positions) noexcept
+{
+    constexpr std::size_t kInterval = PositionTable::kCheckpointInterval;
+    std::size_t node_count = positions.size_;
+    std::size_t checkpoint_count = positions.checkpoints_.size();
+    std::size_t byte_count = positions.bytes_.size();
+    const std::uint8_t *bytes = positions.bytes_.data();
+    if (checkpoint_count != (node_count + kInterval - 1) / kInterval)
+    {
+        return false;
+    }
+
+    /// @note The deltas following each checkpoint end where the next checkpoint starts,
+    /// decoding stays within a range holding as many varint terminators as deltas
+    /// and ending with one. A varint takes at most 10 bytes.
+    std::size_t continuation_run = 0;
+    bool is_too_long = false;
+    for (std::size_t i = 0; i < checkpoint_count; ++i)
+    {
+        std::size_t begin = positions.checkpoints_[i].byte;
+        std::size_t end = (i + 1 < checkpoint_count) ? positions.checkpoints_[i + 1].byte : byte_count;
+        std::size_t delta_count = std::min(kInterval, node_count - i * kInterval) - 1;
+        if ((i == 0 && begin != 0) || begin > end || end > byte_count ||
+            (begin < end && (bytes[end - 1] & 0x80) != 0))
+        {
+            return false;
+        }
+
+        std::size_t terminator_count = 0;
+        for (std::size_t byte = begin; byte < end; ++byte)
+        {
+            bool is_terminator = (bytes[byte] & 0x80) == 0;
+            terminator_count += is_terminator;
+            continuation_run = is_terminator ? 0 : continuation_run + 1;
+            is_too_long |= continuation_run >= 10;
+        }
+        if (terminator_count != delta_count)
+        {
+            return false;
+        }
+    }
+    return !is_too_long;
+}
+
+FlatAst *AstFile::load(const std::string &path)
+{
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(path);
+    SourceView bytes = file->get_view();
+
+    AstFileHeader header;
+    if (bytes.length() < sizeof(header))
+    {
+        __THROW_LOADING_AST_ERROR
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.magic, kAstFileMagic, sizeof(kAstFileMagic)) != 0 || header.version != kAstFileVersion ||
+        header.byte_order_mark != kByteOrderMark || header.node_count == 0)
+    {
+        __THROW_LOADING_AST_ERROR
+    }
+    AstFileLayout layout = compute_layout(header);
+    if (bytes.length() != layout.size)
+    {
+        __THROW_LOADING_AST_ERROR
+    }
+
+    const char *base = bytes.data();
+    std::unique_ptr<FlatAst> ast(new FlatAst());
+    ast->columns_ = FlatAst::Columns{reinterpret_cast<const AstNodeType *>(base + layout.kinds),
+                                     reinterpret_cast<const TokenType *>(base + layout.operators),
+                                     reinterpret_cast<const std::uint32_t *>(base + layout.firsts),
+                                     reinterpret_cast<const std::uint32_t *>(base + layout.seconds),
+                                     reinterpret_cast<const NodeIndex *>(base + layout.children),
+                                     reinterpret_cast<const double *>(base + layout.reals),
+                                     header.node_count,
+                                     header.child_count,
+                                     header.real_count};
+    if (!is_valid_tree(*ast, header.name_count))
+    {
+        __THROW_LOADING_AST_ERROR
+    }
+
+    /// @note Interning the names in symbol order gives them back their symbols
+    const std::uint32_t *name_offsets = reinterpret_cast<const std::uint32_t *>(base + layout.name_offsets);
+    /// @note Increasing offsets from 0 to the size of the names keep every name within them
+    if (name_offsets[0] != 0 || name_offsets[header.name_count] != header.name_byte_count ||
+        !std::is_sorted(name_offsets, name_offsets + header.name_count + 1))
+    {
+        __THROW_LOADING_AST_ERROR
+    }
+    ast->interner_ = std::make_shared<Interner>();
+    for (SymbolId symbol = 0; symbol < header.name_count; ++symbol)
+    {
+        SourceView name(base + layout.names + name_offsets[symbol], name_offsets[symbol + 1] - name_offsets[symbol]);
+        if (ast->interner_->intern(name) != symbol)
+        {
+            __THROW_LOADING_AST_ERROR
+        }
+    }
+
+    const PositionTable::Checkpoint *checkpoints =
+        reinterpret_cast<const PositionTable::Checkpoint *>(base + layout.checkpoints);
+    const std::uint8_t *position_bytes = reinterpret_cast<const std::uint8_t *>(base + layout.positions);
+    PositionTable &positions = ast->positions_;
+    positions.checkpoints_.assign(checkpoints, checkpoints + header.checkpoint_count);
+    positions.bytes_.assign(position_bytes, position_bytes + header.position_byte_count);
+    positions.size_ = header.node_count;
+    if (!is_valid_position_table(positions))
+    {
+        __THROW_LOADING_AST_ERROR
+    }
+
+    ast->mapping_ = std::move(file);
+    return ast.release();
+}
@@ -0,0 +1,52 @@
+#ifndef AST_FILE_HPP
+#define AST_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "flat_ast.hpp"
+
+#define __THROW_LOADING_AST_ERROR \
+    throw std::runtime_error("Error loading AST file");
+
+#define __THROW_SAVING_AST_ERROR \
+    throw std::runtime_error("Error saving AST file");
+
+/// @brief Version of the file layout
+/// @warning Bump it whenever the layout, *AstNodeType* or *TokenType* change,
+/// files of another version are rejected
+constexpr std::uint32_t kAstFileVersion = 1;
+
+/// @brief Binary file holding a *FlatAst*: its node arrays, literals, interned names
+/// and source positions.
+/// @note Nodes refer to each other by index, so the arrays are position-independent:
+/// a loaded tree reads them straight from the memory mapped file, with no per-node
+/// allocation and no pointer fix-up. Only the interner (one entry per distinct name)
+/// and the position table (about a byte per node) are copied.
+///
+/// Layout, every array starting on an 8-byte boundary:
+/// | header | reals | firsts | seconds | children | name offsets | position checkpoints |
+/// | kinds | operators | name characters | position deltas |
+/// @note Files are written in the byte order of the machine (checked on load).
+/// Loading checks every section against the size of the file and every node, child,
+/// literal, name and position against its array (linear in the number of nodes), a
+/// corrupted or truncated file is rejected instead of being read out of bounds.
+class AstFile
+{
+public:
+    /// @brief Write *ast* to the file at *path*, atomically replacing any previous one
+    static void save(const FlatAst &ast, const std::string &path);
+    /// @brief Map the file at *path* and build a tree reading its arrays in place
+    /// @note The mapping is released with the tree
+    static FlatAst *load(const std::string &path);
+
+private:
+    /// @brief Whether the nodes of *ast* form a program its accessors can walk: every node
+    /// refers to earlier nodes (post-order) of the expected kinds, and every child range,
+    /// literal and name (out of *name_count*) is within its array
+    static bool is_valid_tree(const FlatAst &ast, std::size_t name_count) noexcept;
+    /// @brief Whether every position of *positions* decodes without reading past its bytes
+    static bool is_valid_position_table(const PositionTable &positions) noexcept;
+};
+
+#endif
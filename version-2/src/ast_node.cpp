@@ -1,44 +1,59 @@
 #include "ast_node.hpp"
-#include <vector>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include "token.hpp"
 
 AstNode::AstNode(AstNodeType type) : type_{type} {}
 AstNode::~AstNode() {}
-AstNodeType AstNode::get_type() const noexcept { return type_; }
 
-VariableNode::VariableNode(const std::string &name) : AstNode{AstNodeType::VARIABLE}, name_{name} {}
-VariableNode::VariableNode(std::string &&name) : AstNode{AstNodeType::VARIABLE}, name_{std::move(name)} {}
-const std::string &VariableNode::get_name() const noexcept { return name_; }
+VariableNode::VariableNode(SymbolId symbol) : AstNode{AstNodeType::VARIABLE}, symbol_{symbol} {}
+SymbolId VariableNode::get_symbol() const noexcept { return symbol_; }
 
 // TypeNode::TypeNode(Token *token) : AstNode{AstNodeType::TYPE}, token_{token} {}
 // TypeNode::TypeNode(const TypeNode &node)
 //     : AstNode{AstNodeType::TYPE}, token_{new Token(*(node.get_token()))} {}
 TypeNode::TypeNode(Token *token) : TokenHolderNode{AstNodeType::TYPE, token} {}
 TypeNode::TypeNode(const TypeNode &node)
-    : TokenHolderNode{AstNodeType::TYPE, new Token(*(node.get_token()))} {}
+    : TokenHolderNode{AstNodeType::TYPE, node.get_token()} {}
 // TypeNode::~TypeNode() { delete token_; }
 // Token *TypeNode::get_token() const noexcept { return token_; }
 
-CompoundStatementNode::CompoundStatementNode(std::vector<AstNode *> &&statement_list)
-    : AstNode{AstNodeType::COMPOUND_STATEMENT}, statement_list_{std::move(statement_list)} {}
-std::vector<AstNode *> CompoundStatementNode::get_statement_list() const noexcept { return statement_list_; }
+CompoundStatementNode::CompoundStatementNode(AstNode **statements, std::size_t statement_count)
+    : AstNode{AstNodeType::COMPOUND_STATEMENT}, statements_{statements}, statement_count_{statement_count} {}
+NodeSpan<AstNode> CompoundStatementNode::get_statement_list() const noexcept
+{
+    return NodeSpan<AstNode>(statements_, statement_count_);
+}
+AstNode *CompoundStatementNode::replace_statement(std::size_t index, AstNode *statement) noexcept
+{
+    std::swap(statements_[index], statement);
+    return statement;
+}
 
 VarDeclNode::VarDeclNode(VariableNode *var_node, TypeNode *type_node)
     : AstNode{AstNodeType::VARIABLE_DECLARATION}, var_{var_node}, type_{type_node} {}
 VariableNode *VarDeclNode::get_var_node() const noexcept { return var_; }
 TypeNode *VarDeclNode::get_type_node() const noexcept { return type_; }
 
-BlockNode::BlockNode(std::vector<VarDeclNode *> &&declarations, CompoundStatementNode *compound_statement)
-    : AstNode{AstNodeType::BLOCK}, declarations_{std::move(declarations)}, compound_statement_{compound_statement} {}
-std::vector<VarDeclNode *> BlockNode::get_declaration_nodes() const noexcept { return declarations_; }
+BlockNode::BlockNode(VarDeclNode **declarations, std::size_t declaration_count, CompoundStatementNode *compound_statement)
+    : AstNode{AstNodeType::BLOCK}, declarations_{declarations}, declaration_count_{declaration_count},
+      compound_statement_{compound_statement} {}
+NodeSpan<VarDeclNode> BlockNode::get_declaration_nodes() const noexcept
+{
+    return NodeSpan<VarDeclNode>(declarations_, declaration_count_);
+}
 CompoundStatementNode *BlockNode::get_compound_statement_node() const noexcept { return compound_statement_; }
-
-ProgramNode::ProgramNode(const std::string &name, BlockNode *block)
-    : AstNode{AstNodeType::PROGRAM}, name_{name}, block_{block} {}
-ProgramNode::ProgramNode(std::string &&name, BlockNode *block)
-    : AstNode{AstNodeType::PROGRAM}, name_{std::move(name)}, block_{block} {}
-const std::string &ProgramNode::get_name() const noexcept { return name_; }
+CompoundStatementNode *BlockNode::replace_compound_statement_node(CompoundStatementNode *compound_statement) noexcept
+{
+    CompoundStatementNode *replaced = compound_statement_;
+    compound_statement_ = compound_statement;
+    return replaced;
+}
+
+ProgramNode::ProgramNode(SymbolId symbol, BlockNode *block)
+    : AstNode{AstNodeType::PROGRAM}, symbol_{symbol}, block_{block} {}
+SymbolId ProgramNode::get_symbol() const noexcept { return symbol_; }
 BlockNode *ProgramNode::get_block_node() const noexcept { return block_; }
 
 AssignmentStatementNode::AssignmentStatementNode(VariableNode *lhs, AstNode *rhs)
@@ -48,14 +63,14 @@ AstNode *AssignmentStatementNode::get_rhs() const noexcept { return rhs_; }
 
 NoOperationNode::NoOperationNode() : AstNode{AstNodeType::NO_OPERATION} {}
 
+ErrorNode::ErrorNode() : AstNode{AstNodeType::ERROR} {}
+
 // BinaryOperatorNode::BinaryOperatorNode(Token *token, AstNode *lhs, AstNode *rhs)
 //     : AstNode{AstNodeType::BINARY_OPERATOR}, token_{token}, lhs_{lhs}, rhs_{rhs} {}
 BinaryOperatorNode::BinaryOperatorNode(Token *token, AstNode *lhs, AstNode *rhs)
     : TokenHolderNode{AstNodeType::BINARY_OPERATOR, token}, lhs_{lhs}, rhs_{rhs} {}
 // BinaryOperatorNode::~BinaryOperatorNode() { delete token_; }
 // Token *BinaryOperatorNode::get_token() const noexcept { return token_; }
-AstNode *BinaryOperatorNode::get_lhs() const noexcept { return lhs_; }
-AstNode *BinaryOperatorNode::get_rhs() const noexcept { return rhs_; }
 
 // UnaryOperatorNode::UnaryOperatorNode(Token *token, AstNode *rhs)
 //     : AstNode{AstNodeType::UNARY_OPERATOR}, token_{token}, rhs_{rhs} {}
@@ -63,7 +78,6 @@ UnaryOperatorNode::UnaryOperatorNode(Token *token, AstNode *rhs)
     : TokenHolderNode{AstNodeType::UNARY_OPERATOR, token}, rhs_{rhs} {}
 // UnaryOperatorNode::~UnaryOperatorNode() { delete token_; }
 // Token *UnaryOperatorNode::get_token() const noexcept { return token_; }
-AstNode *UnaryOperatorNode::get_rhs() const noexcept { return rhs_; }
 
 // IntNumNode::IntNumNode(IntNumToken *token) : AstNode{AstNodeType::INT_NUM}, token_{token} {}
 IntNumNode::IntNumNode(IntNumToken *token) : TokenHolderNode{AstNodeType::INT_NUM, token} {}
@@ -75,6 +89,53 @@ RealNumNode::RealNumNode(RealNumToken *token) : TokenHolderNode{AstNodeType::REA
 // RealNumNode::~RealNumNode() { delete token_; }
 // RealNumToken *RealNumNode::get_token() const noexcept { return token_; }
 
+const char *map_operation_to_string(Operation operation) noexcept
+{
+    switch (operation)
+    {
+    case Operation::NONE:
+        return "NONE";
+    case Operation::INTEGER_CONSTANT:
+        return "INTEGER_CONSTANT";
+    case Operation::INTEGER_LOAD:
+        return "INTEGER_LOAD";
+    case Operation::INTEGER_ADD:
+        return "INTEGER_ADD";
+    case Operation::INTEGER_SUBTRACT:
+        return "INTEGER_SUBTRACT";
+    case Operation::INTEGER_MULTIPLY:
+        return "INTEGER_MULTIPLY";
+    case Operation::INTEGER_DIVIDE:
+        return "INTEGER_DIVIDE";
+    case Operation::INTEGER_NEGATE:
+        return "INTEGER_NEGATE";
+    case Operation::INTEGER_IDENTITY:
+        return "INTEGER_IDENTITY";
+    case Operation::REAL_CONSTANT:
+        return "REAL_CONSTANT";
+    case Operation::REAL_LOAD:
+        return "REAL_LOAD";
+    case Operation::REAL_ADD:
+        return "REAL_ADD";
+    case Operation::REAL_SUBTRACT:
+        return "REAL_SUBTRACT";
+    case Operation::REAL_MULTIPLY:
+        return "REAL_MULTIPLY";
+    case Operation::REAL_DIVIDE:
+        return "REAL_DIVIDE";
+    case Operation::REAL_NEGATE:
+        return "REAL_NEGATE";
+    case Operation::REAL_IDENTITY:
+        return "REAL_IDENTITY";
+    case Operation::INTEGER_STORE:
+        return "INTEGER_STORE";
+    case Operation::REAL_STORE:
+        return "REAL_STORE";
+    default:
+        return "UNKNOWN";
+    }
+}
+
 const std::string &map_ast_node_type_to_string(AstNodeType type)
 {
     static const std::unordered_map<AstNodeType, std::string> typeToString = {
@@ -89,7 +150,8 @@ const std::string &map_ast_node_type_to_string(AstNodeType type)
         {AstNodeType::TYPE, "TYPE"},
         {AstNodeType::INT_NUM, "INT_NUM"},
         {AstNodeType::REAL_NUM, "REAL_NUM"},
-        {AstNodeType::NO_OPERATION, "NO_OPERATION"}};
+        {AstNodeType::NO_OPERATION, "NO_OPERATION"},
+        {AstNodeType::ERROR, "ERROR"}};
 
     static const std::string unknown = "UNKNOWN AST NODE";
 
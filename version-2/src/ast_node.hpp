@@ -1,8 +1,10 @@
 #ifndef AST_NODE_HPP
 #define AST_NODE_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
-#include <vector>
+#include "interner.hpp"
 #include "token.hpp"
 
 enum class AstNodeType : unsigned char
@@ -19,7 +21,72 @@ enum class AstNodeType : unsigned char
     INT_NUM,
     REAL_NUM,
     /// @brief Present an empty statement
-    NO_OPERATION
+    NO_OPERATION,
+    /// @brief Stand-in for an expression that failed to parse (*ErrorMode::COLLECT* only)
+    ERROR
+};
+
+/// @brief Concrete typed operation of a node, chosen by the *SemanticAnalyzer*
+/// @note The INTEGER_ operations produce an INTEGER, the REAL_ ones a REAL,
+/// so an evaluator knows the type of every value without checking it at run time
+enum class Operation : unsigned char
+{
+    /// @brief Not analyzed, or not an expression nor an assignment
+    NONE,
+
+    // MARK: INTEGER results
+
+    INTEGER_CONSTANT,
+    INTEGER_LOAD,
+    INTEGER_ADD,
+    INTEGER_SUBTRACT,
+    INTEGER_MULTIPLY,
+    INTEGER_DIVIDE,
+    INTEGER_NEGATE,
+    INTEGER_IDENTITY,
+
+    // MARK: REAL results
+
+    REAL_CONSTANT,
+    REAL_LOAD,
+    REAL_ADD,
+    REAL_SUBTRACT,
+    REAL_MULTIPLY,
+    REAL_DIVIDE,
+    REAL_NEGATE,
+    REAL_IDENTITY,
+
+    // MARK: Assignments
+
+    INTEGER_STORE,
+    REAL_STORE
+};
+
+const char *map_operation_to_string(Operation operation) noexcept;
+
+/// @brief Index of a variable in the flat variable array of an executed program
+using SlotIndex = std::uint32_t;
+
+/// @brief Marks a variable that has not been resolved (yet)
+constexpr SlotIndex kNoSlot = UINT32_MAX;
+
+/// @brief Read-only view over the children stored in a node, iterating it never allocates
+/// @note Stand-in for std::span, which is not available in C++ 14.
+template <typename TNode>
+class NodeSpan
+{
+public:
+    NodeSpan(TNode *const *nodes, std::size_t size) noexcept : nodes_{nodes}, size_{size} {}
+
+    TNode *const *begin() const noexcept { return nodes_; }
+    TNode *const *end() const noexcept { return nodes_ + size_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    TNode *operator[](std::size_t index) const noexcept { return nodes_[index]; }
+
+private:
+    TNode *const *nodes_;
+    std::size_t size_;
 };
 
 /// @brief Base AST node
@@ -29,12 +96,30 @@ public:
     explicit AstNode(AstNodeType type);
     virtual ~AstNode();
 
-    AstNodeType get_type() const noexcept;
+    AstNodeType get_type() const noexcept { return type_; }
+    /// @brief Offset in the source code of the token the node was built from
+    /// (operator, literal, identifier, keyword opening the construct, ...)
+    std::uint32_t get_offset() const noexcept { return offset_; }
+    void set_offset(std::uint32_t offset) noexcept { offset_ = offset; }
+
+    /// @brief Typed operation of the node, *Operation::NONE* until analyzed
+    Operation get_operation() const noexcept { return operation_; }
+    void set_operation(Operation operation) noexcept { operation_ = operation; }
+    /// @brief Whether the INTEGER value of this expression is promoted to REAL by its user
+    /// (a REAL operation or a REAL variable)
+    bool is_promoted() const noexcept { return promoted_; }
+    void set_promoted(bool promoted) noexcept { promoted_ = promoted; }
 
 protected:
     AstNodeType type_;
+    /// @note The annotations and the offset fill the padding after type_, they cost no memory
+    Operation operation_ = Operation::NONE;
+    bool promoted_ = false;
+    std::uint32_t offset_ = 0;
 };
 
+static_assert(sizeof(AstNode) == sizeof(void *) + 2 * sizeof(std::uint32_t), "AstNode must stay compact");
+
 /// @brief AST node containing a token
 /// @note Since *TokenHolderNode* is a templated class, the compiler does not generate code for it
 /// until it is instantiated with a specific type (*IntNumToken* in this case).
@@ -43,12 +128,12 @@ protected:
 ///
 /// To fix this, the implementation must be included in the same translation unit where the class template is used.
 /// This is why template definitions are usually placed in header files.
+/// @note The token is not owned, like the node it lives in the arena of the *AbstractSyntaxTree*.
 template <typename TToken>
 class TokenHolderNode : public AstNode
 {
 public:
     TokenHolderNode(AstNodeType type, TToken *token) : AstNode{type}, token_{token} {}
-    virtual ~TokenHolderNode() { delete token_; }
 
     /// @brief Get token belong to this node
     TToken *get_token() const noexcept { return token_; }
@@ -60,33 +145,45 @@ protected:
 class VariableNode : public AstNode
 {
 public:
-    explicit VariableNode(const std::string &name);
-    explicit VariableNode(std::string &&name);
+    explicit VariableNode(SymbolId symbol);
 
-    /// @brief Get variable name
-    const std::string &get_name() const noexcept;
+    /// @brief Get interned variable name
+    SymbolId get_symbol() const noexcept;
+    /// @brief Slot of the variable, *kNoSlot* until resolved (see *Interpreter*)
+    SlotIndex get_slot() const noexcept { return slot_; }
+    void set_slot(SlotIndex slot) noexcept { slot_ = slot; }
 
 protected:
     /// @brief var name
-    std::string name_;
+    SymbolId symbol_;
+    /// @note Fills the padding after symbol_
+    SlotIndex slot_ = kNoSlot;
 };
 
+static_assert(sizeof(VariableNode) == sizeof(AstNode) + sizeof(void *), "VariableNode must stay compact");
+
 class TypeNode : public TokenHolderNode<Token>
 {
 public:
     explicit TypeNode(Token *token);
+    /// @note Both nodes share the same token
     TypeNode(const TypeNode &node);
 };
 
 class CompoundStatementNode : public AstNode
 {
 public:
-    explicit CompoundStatementNode(std::vector<AstNode *> &&statement_list);
+    /// @note *statements* is not copied, it must live as long as the node (e.g. in the same arena)
+    CompoundStatementNode(AstNode **statements, std::size_t statement_count);
 
-    std::vector<AstNode *> get_statement_list() const noexcept;
+    NodeSpan<AstNode> get_statement_list() const noexcept;
+    /// @brief Put *statement* in place of the statement at *index*
+    /// @return The replaced statement, now owned by the caller
+    AstNode *replace_statement(std::size_t index, AstNode *statement) noexcept;
 
 protected:
-    std::vector<AstNode *> statement_list_;
+    AstNode **statements_;
+    std::size_t statement_count_;
 };
 
 class VarDeclNode : public AstNode
@@ -109,29 +206,33 @@ protected:
 class BlockNode : public AstNode
 {
 public:
-    BlockNode(std::vector<VarDeclNode *> &&declarations, CompoundStatementNode *compound_statement);
+    /// @note *declarations* is not copied, it must live as long as the node (e.g. in the same arena)
+    BlockNode(VarDeclNode **declarations, std::size_t declaration_count, CompoundStatementNode *compound_statement);
 
-    std::vector<VarDeclNode *> get_declaration_nodes() const noexcept;
+    NodeSpan<VarDeclNode> get_declaration_nodes() const noexcept;
     CompoundStatementNode *get_compound_statement_node() const noexcept;
+    /// @brief Put *compound_statement* in place of the compound statement of the block
+    /// @return The replaced compound statement, now owned by the caller
+    CompoundStatementNode *replace_compound_statement_node(CompoundStatementNode *compound_statement) noexcept;
 
 private:
-    std::vector<VarDeclNode *> declarations_;
+    VarDeclNode **declarations_;
+    std::size_t declaration_count_;
     CompoundStatementNode *compound_statement_;
 };
 
 class ProgramNode : public AstNode
 {
 public:
-    ProgramNode(const std::string &name, BlockNode *block);
-    ProgramNode(std::string &&name, BlockNode *block);
+    ProgramNode(SymbolId symbol, BlockNode *block);
 
-    /// @brief Get program name
-    const std::string &get_name() const noexcept;
+    /// @brief Get interned program name
+    SymbolId get_symbol() const noexcept;
     /// @brief Get block node
     BlockNode *get_block_node() const noexcept;
 
 private:
-    std::string name_;
+    SymbolId symbol_;
     BlockNode *block_;
 };
 
@@ -154,13 +255,21 @@ public:
     NoOperationNode();
 };
 
+/// @note Only found in trees parsed with *ErrorMode::COLLECT* that have errors
+class ErrorNode : public AstNode
+{
+public:
+    /// @note The offset of the node is the one of the token that could not be parsed
+    ErrorNode();
+};
+
 class BinaryOperatorNode : public TokenHolderNode<Token>
 {
 public:
     BinaryOperatorNode(Token *token, AstNode *lhs, AstNode *rhs);
 
-    AstNode *get_lhs() const noexcept;
-    AstNode *get_rhs() const noexcept;
+    AstNode *get_lhs() const noexcept { return lhs_; }
+    AstNode *get_rhs() const noexcept { return rhs_; }
 
 protected:
     AstNode *lhs_;
@@ -172,7 +281,7 @@ class UnaryOperatorNode : public TokenHolderNode<Token>
 public:
     UnaryOperatorNode(Token *token, AstNode *rhs);
 
-    AstNode *get_rhs() const noexcept;
+    AstNode *get_rhs() const noexcept { return rhs_; }
 
 protected:
     AstNode *rhs_;
@@ -0,0 +1,182 @@
+#ifndef AST_VISITOR_HPP
+#define AST_VISITOR_HPP
+
+#include <stdexcept>
+#include <vector>
+#include "ast_node.hpp"
+
+/// @brief Statically dispatched AST visitor (CRTP).
+/// @note A pass derives from *AstVisitor<Pass, Result>* and hides the *visit_...()* handlers
+/// it cares about, *visit()* calls them without any virtual call. Handlers that are not
+/// hidden visit every child in source order and return *TResult()*.
+/// ```cpp
+/// class VariableCounter : public AstVisitor<VariableCounter>
+/// {
+/// public:
+///     std::size_t count = 0;
+///     void visit_variable(VariableNode *) { count++; }
+/// };
+/// ```
+template <typename TDerived, typename TResult = void>
+class AstVisitor
+{
+public:
+    /// @brief Call the handler matching the type of *node*
+    TResult visit(AstNode *node)
+    {
+        TDerived &derived = static_cast<TDerived &>(*this);
+        switch (node->get_type())
+        {
+        case AstNodeType::PROGRAM:
+            return derived.visit_program(static_cast<ProgramNode *>(node));
+        case AstNodeType::BLOCK:
+            return derived.visit_block(static_cast<BlockNode *>(node));
+        case AstNodeType::COMPOUND_STATEMENT:
+            return derived.visit_compound_statement(static_cast<CompoundStatementNode *>(node));
+        case AstNodeType::VARIABLE_DECLARATION:
+            return derived.visit_variable_declaration(static_cast<VarDeclNode *>(node));
+        case AstNodeType::ASSIGNMENT_STATEMENT:
+            return derived.visit_assignment_statement(static_cast<AssignmentStatementNode *>(node));
+        case AstNodeType::BINARY_OPERATOR:
+            return derived.visit_binary_operator(static_cast<BinaryOperatorNode *>(node));
+        case AstNodeType::UNARY_OPERATOR:
+            return derived.visit_unary_operator(static_cast<UnaryOperatorNode *>(node));
+        case AstNodeType::VARIABLE:
+            return derived.visit_variable(static_cast<VariableNode *>(node));
+        case AstNodeType::TYPE:
+            return derived.visit_type(static_cast<TypeNode *>(node));
+        case AstNodeType::INT_NUM:
+            return derived.visit_int_num(static_cast<IntNumNode *>(node));
+        case AstNodeType::REAL_NUM:
+            return derived.visit_real_num(static_cast<RealNumNode *>(node));
+        case AstNodeType::NO_OPERATION:
+            return derived.visit_no_operation(static_cast<NoOperationNode *>(node));
+        case AstNodeType::ERROR:
+            return derived.visit_error(static_cast<ErrorNode *>(node));
+        default:
+            throw std::runtime_error("Unknow ast node type");
+        }
+    }
+
+    // MARK: Default handlers
+
+    TResult visit_program(ProgramNode *node)
+    {
+        visit(node->get_block_node());
+        return TResult();
+    }
+    TResult visit_block(BlockNode *node)
+    {
+        for (VarDeclNode *declaration : node->get_declaration_nodes())
+        {
+            visit(declaration);
+        }
+        visit(node->get_compound_statement_node());
+        return TResult();
+    }
+    TResult visit_compound_statement(CompoundStatementNode *node)
+    {
+        for (AstNode *statement : node->get_statement_list())
+        {
+            visit(statement);
+        }
+        return TResult();
+    }
+    TResult visit_variable_declaration(VarDeclNode *node)
+    {
+        visit(node->get_var_node());
+        visit(node->get_type_node());
+        return TResult();
+    }
+    TResult visit_assignment_statement(AssignmentStatementNode *node)
+    {
+        visit(node->get_lhs());
+        visit(node->get_rhs());
+        return TResult();
+    }
+    TResult visit_binary_operator(BinaryOperatorNode *node)
+    {
+        visit(node->get_lhs());
+        visit(node->get_rhs());
+        return TResult();
+    }
+    TResult visit_unary_operator(UnaryOperatorNode *node)
+    {
+        visit(node->get_rhs());
+        return TResult();
+    }
+    TResult visit_variable(VariableNode *) { return TResult(); }
+    TResult visit_type(TypeNode *) { return TResult(); }
+    TResult visit_int_num(IntNumNode *) { return TResult(); }
+    TResult visit_real_num(RealNumNode *) { return TResult(); }
+    TResult visit_no_operation(NoOperationNode *) { return TResult(); }
+    TResult visit_error(ErrorNode *) { return TResult(); }
+};
+
+/// @brief Walks an expression in post-order (operands before their operator, lhs before rhs)
+/// over an explicit stack, for the passes computing a value per expression node
+/// @note Generated programs nest expressions 100k deep (long chains of operators or of signs),
+/// recursing once per node would overflow the native stack. A pass keeps the values of the
+/// operands on a stack of its own: a leaf pushes its value, an operator pops the values of its
+/// operands and pushes its own.
+/// ```cpp
+/// walker_.walk(node, [&](AstNode *node) { ... });
+/// ```
+/// The frames are kept from one walk to the next, walking allocates nothing once they have grown.
+/// @warning *visit* must not start another walk of the same walker
+class ExpressionWalker
+{
+public:
+    /// @brief Call *visit(node)* on every node of the expression *root*, in post-order
+    template <typename TVisit>
+    void walk(AstNode *root, TVisit &&visit)
+    {
+        /// @note A previous walk may have been left by an exception
+        stack_.clear();
+        AstNode *node = root;
+        while (true)
+        {
+            /// @note Down the first operands to a leaf, only operators are pushed
+            AstNodeType type = node->get_type();
+            while (type == AstNodeType::BINARY_OPERATOR || type == AstNodeType::UNARY_OPERATOR)
+            {
+                stack_.push_back(Frame{node, false});
+                node = (type == AstNodeType::BINARY_OPERATOR) ? static_cast<BinaryOperatorNode *>(node)->get_lhs()
+                                                              : static_cast<UnaryOperatorNode *>(node)->get_rhs();
+                type = node->get_type();
+            }
+            visit(node);
+
+            /// @note Up through the operators whose operands are all visited, to the next rhs
+            while (true)
+            {
+                if (stack_.empty())
+                {
+                    return;
+                }
+                Frame &frame = stack_.back();
+                if (!frame.on_rhs && frame.node->get_type() == AstNodeType::BINARY_OPERATOR)
+                {
+                    frame.on_rhs = true;
+                    node = static_cast<BinaryOperatorNode *>(frame.node)->get_rhs();
+                    break;
+                }
+                node = frame.node;
+                stack_.pop_back();
+                visit(node);
+            }
+        }
+    }
+
+private:
+    struct Frame
+    {
+        AstNode *node;
+        /// @brief The lhs of the binary operator *node* was visited, its rhs is being walked
+        bool on_rhs;
+    };
+
+    std::vector<Frame> stack_;
+};
+
+#endif
@@ -0,0 +1,246 @@
+#include "bytecode.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include "ast.hpp"
+#include "token.hpp"
+
+const char *map_opcode_to_string(Opcode opcode) noexcept
+{
+    switch (opcode)
+    {
+    case Opcode::INTEGER_PUSH:
+        return "INTEGER_PUSH";
+    case Opcode::REAL_PUSH:
+        return "REAL_PUSH";
+    case Opcode::INTEGER_LOAD:
+        return "INTEGER_LOAD";
+    case Opcode::REAL_LOAD:
+        return "REAL_LOAD";
+    case Opcode::INTEGER_STORE:
+        return "INTEGER_STORE";
+    case Opcode::REAL_STORE:
+        return "REAL_STORE";
+    case Opcode::INTEGER_ADD:
+        return "INTEGER_ADD";
+    case Opcode::INTEGER_SUBTRACT:
+        return "INTEGER_SUBTRACT";
+    case Opcode::INTEGER_MULTIPLY:
+        return "INTEGER_MULTIPLY";
+    case Opcode::INTEGER_DIVIDE:
+        return "INTEGER_DIVIDE";
+    case Opcode::INTEGER_NEGATE:
+        return "INTEGER_NEGATE";
+    case Opcode::REAL_ADD:
+        return "REAL_ADD";
+    case Opcode::REAL_SUBTRACT:
+        return "REAL_SUBTRACT";
+    case Opcode::REAL_MULTIPLY:
+        return "REAL_MULTIPLY";
+    case Opcode::REAL_DIVIDE:
+        return "REAL_DIVIDE";
+    case Opcode::REAL_NEGATE:
+        return "REAL_NEGATE";
+    case Opcode::INTEGER_TO_REAL:
+        return "INTEGER_TO_REAL";
+    case Opcode::HALT:
+        return "HALT";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+bool has_operand(Opcode opcode) noexcept
+{
+    return opcode == Opcode::INTEGER_PUSH || opcode == Opcode::REAL_PUSH || opcode == Opcode::INTEGER_LOAD ||
+           opcode == Opcode::REAL_LOAD || opcode == Opcode::INTEGER_STORE || opcode == Opcode::REAL_STORE;
+}
+
+std::uint32_t locate_instruction(const std::vector<InstructionLocation> &locations, std::uint32_t instruction) noexcept
+{
+    auto location = std::lower_bound(locations.begin(), locations.end(), instruction,
+                                     [](const InstructionLocation &location, std::uint32_t instruction)
+                                     { return location.instruction < instruction; });
+    return (location != locations.end() && location->instruction == instruction) ? location->offset : 0;
+}
+
+/// @brief Instruction of a binary *operation*
+static Opcode binary_opcode(Operation operation) noexcept
+{
+    switch (operation)
+    {
+    case Operation::INTEGER_ADD:
+        return Opcode::INTEGER_ADD;
+    case Operation::INTEGER_SUBTRACT:
+        return Opcode::INTEGER_SUBTRACT;
+    case Operation::INTEGER_MULTIPLY:
+        return Opcode::INTEGER_MULTIPLY;
+    case Operation::INTEGER_DIVIDE:
+        return Opcode::INTEGER_DIVIDE;
+    case Operation::REAL_ADD:
+        return Opcode::REAL_ADD;
+    case Operation::REAL_SUBTRACT:
+        return Opcode::REAL_SUBTRACT;
+    case Operation::REAL_MULTIPLY:
+        return Opcode::REAL_MULTIPLY;
+    default:
+        return Opcode::REAL_DIVIDE;
+    }
+}
+
+BytecodeCompiler::BytecodeCompiler(const SemanticAnalyzer &analyzer) : analyzer_{analyzer}
+{
+    if (analyzer.has_errors())
+    {
+        __THROW_COMPILING_ERROR
+    }
+}
+
+BytecodeProgram BytecodeCompiler::compile()
+{
+    program_ = BytecodeProgram();
+    program_.variables = analyzer_.get_variables();
+    program_.interner = analyzer_.get_ast()->get_interner();
+    real_indexes_.clear();
+    stack_depth_ = 0;
+
+    visit(analyzer_.get_ast()->get_root());
+    emit(Opcode::HALT);
+    return std::move(program_);
+}
+
+void BytecodeCompiler::emit(Opcode opcode) { program_.code.push_back(static_cast<std::uint8_t>(opcode)); }
+
+void BytecodeCompiler::emit(Opcode opcode, std::uint32_t operand)
+{
+    emit(opcode);
+    std::size_t position = program_.code.size();
+    program_.code.resize(position + sizeof(operand));
+    std::memcpy(&program_.code[position], &operand, sizeof(operand));
+}
+
+void BytecodeCompiler::adjust_stack(int delta) noexcept
+{
+    stack_depth_ += delta;
+    if (stack_depth_ > program_.max_stack_depth)
+    {
+        program_.max_stack_depth = stack_depth_;
+    }
+}
+
+void BytecodeCompiler::visit_block(BlockNode *node)
+{
+    /// @note Declarations were handled by the analyzer
+    visit(node->get_compound_statement_node());
+}
+
+void BytecodeCompiler::visit_assignment_statement(AssignmentStatementNode *node)
+{
+    compile_expression(node->get_rhs());
+    Opcode store = (node->get_operation() == Operation::REAL_STORE) ? Opcode::REAL_STORE : Opcode::INTEGER_STORE;
+    emit(store, node->get_lhs()->get_slot());
+    adjust_stack(-1);
+}
+
+void BytecodeCompiler::compile_expression(AstNode *node)
+{
+    walker_.walk(node, [this](AstNode *node) { compile_node(node); });
+}
+
+void BytecodeCompiler::compile_node(AstNode *node)
+{
+    Operation operation = node->get_operation();
+    switch (operation)
+    {
+    case Operation::INTEGER_CONSTANT:
+        emit(Opcode::INTEGER_PUSH, static_cast<std::uint32_t>(static_cast<IntNumNode *>(node)->get_token()->get_value()));
+        adjust_stack(1);
+        break;
+    case Operation::REAL_CONSTANT:
+    {
+        double value = static_cast<RealNumNode *>(node)->get_token()->get_value();
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        auto inserted = real_indexes_.emplace(bits, static_cast<std::uint32_t>(program_.reals.size()));
+        if (inserted.second)
+        {
+            program_.reals.push_back(value);
+        }
+        emit(Opcode::REAL_PUSH, inserted.first->second);
+        adjust_stack(1);
+        break;
+    }
+    case Operation::INTEGER_LOAD:
+    case Operation::REAL_LOAD:
+        emit((operation == Operation::REAL_LOAD) ? Opcode::REAL_LOAD : Opcode::INTEGER_LOAD,
+             static_cast<VariableNode *>(node)->get_slot());
+        adjust_stack(1);
+        break;
+    case Operation::INTEGER_ADD:
+    case Operation::INTEGER_SUBTRACT:
+    case Operation::INTEGER_MULTIPLY:
+    case Operation::INTEGER_DIVIDE:
+    case Operation::REAL_ADD:
+    case Operation::REAL_SUBTRACT:
+    case Operation::REAL_MULTIPLY:
+    case Operation::REAL_DIVIDE:
+        if (operation == Operation::INTEGER_DIVIDE)
+        {
+            program_.locations.push_back({static_cast<std::uint32_t>(program_.code.size()), node->get_offset()});
+        }
+        emit(binary_opcode(operation));
+        adjust_stack(-1);
+        break;
+    case Operation::INTEGER_NEGATE:
+    case Operation::REAL_NEGATE:
+        emit((operation == Operation::REAL_NEGATE) ? Opcode::REAL_NEGATE : Opcode::INTEGER_NEGATE);
+        break;
+    case Operation::INTEGER_IDENTITY:
+    case Operation::REAL_IDENTITY:
+        /// @note Unary plus compiles to nothing
+        break;
+    default:
+        __THROW_COMPILING_ERROR
+    }
+
+    if (node->is_promoted())
+    {
+        emit(Opcode::INTEGER_TO_REAL);
+    }
+}
+
+void disassemble(const BytecodeProgram &program, std::ostream &os)
+{
+    std::size_t offset = 0;
+    while (offset < program.code.size())
+    {
+        Opcode opcode = static_cast<Opcode>(program.code[offset]);
+        os << std::setw(6) << std::setfill('0') << offset << std::setfill(' ') << "  ";
+        offset++;
+        if (!has_operand(opcode))
+        {
+            os << map_opcode_to_string(opcode) << '\n';
+            continue;
+        }
+        os << std::left << std::setw(18) << map_opcode_to_string(opcode) << std::right;
+
+        std::uint32_t operand;
+        std::memcpy(&operand, &program.code[offset], sizeof(operand));
+        offset += sizeof(operand);
+        switch (opcode)
+        {
+        case Opcode::INTEGER_PUSH:
+            os << static_cast<int>(operand);
+            break;
+        case Opcode::REAL_PUSH:
+            os << operand << "  ; " << program.reals[operand];
+            break;
+        default:
+            os << operand << "  ; " << program.interner->get_name(program.variables[operand].name).to_string();
+            break;
+        }
+        os << '\n';
+    }
+}
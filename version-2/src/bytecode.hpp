@@ -0,0 +1,140 @@
+#ifndef BYTECODE_HPP
+#define BYTECODE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+#include "ast_node.hpp"
+#include "ast_visitor.hpp"
+#include "interner.hpp"
+#include "semantic_analyzer.hpp"
+#include "value.hpp"
+
+#define __THROW_COMPILING_ERROR \
+    throw std::runtime_error("Error compiling program");
+
+#define __THROW_EXECUTING_ERROR \
+    throw std::runtime_error("Error executing bytecode");
+
+/// @brief Untyped value of a stack entry, a register or a variable of a virtual machine,
+/// the instruction using it knows its type
+union Cell
+{
+    int integer;
+    double real;
+};
+
+/// @brief Instructions of a *BytecodeProgram*
+/// @note Every instruction is a one-byte opcode, followed by a 4-byte operand for the ones
+/// marked so. Operations are typed like *Operation*, values are never checked at run time.
+enum class Opcode : unsigned char
+{
+    /// @brief Push the INTEGER operand (an immediate)
+    INTEGER_PUSH,
+    /// @brief Push the REAL constant at the operand index of the constant pool
+    REAL_PUSH,
+    /// @brief Push the variable in the operand slot
+    INTEGER_LOAD,
+    REAL_LOAD,
+    /// @brief Pop into the variable in the operand slot
+    INTEGER_STORE,
+    REAL_STORE,
+
+    INTEGER_ADD,
+    INTEGER_SUBTRACT,
+    INTEGER_MULTIPLY,
+    INTEGER_DIVIDE,
+    INTEGER_NEGATE,
+
+    REAL_ADD,
+    REAL_SUBTRACT,
+    REAL_MULTIPLY,
+    REAL_DIVIDE,
+    REAL_NEGATE,
+
+    /// @brief Convert the INTEGER on top of the stack to REAL
+    INTEGER_TO_REAL,
+
+    /// @brief End of the program
+    HALT
+};
+
+const char *map_opcode_to_string(Opcode opcode) noexcept;
+
+/// @brief Whether *opcode* is followed by a 4-byte operand
+bool has_operand(Opcode opcode) noexcept;
+
+/// @brief Source offset of an instruction that may fail at run time
+struct InstructionLocation
+{
+    /// @brief Position of the instruction in its code (a byte offset or an instruction index)
+    std::uint32_t instruction;
+    /// @brief Offset in the source code of the operator it was compiled from
+    std::uint32_t offset;
+};
+
+/// @brief Source offset of *instruction*, looked up in *locations* sorted by instruction
+/// @note Only called once a program fails, the hot loops never read locations
+std::uint32_t locate_instruction(const std::vector<InstructionLocation> &locations, std::uint32_t instruction) noexcept;
+
+/// @brief Program compiled to a linear bytecode
+struct BytecodeProgram
+{
+    std::vector<std::uint8_t> code;
+    /// @brief Constant pool of the REAL literals
+    std::vector<double> reals;
+    /// @brief Declared variables, indexed by slot
+    std::vector<VariableSymbol> variables;
+    std::shared_ptr<Interner> interner;
+    /// @brief Highest number of values on the stack while running
+    std::size_t max_stack_depth = 0;
+    /// @brief Location of every INTEGER_DIVIDE, the only instruction failing at run time, by code offset
+    std::vector<InstructionLocation> locations;
+};
+
+/// @brief Compiles an analyzed tree (see *SemanticAnalyzer*) to bytecode
+/// @note Expressions are emitted in post-order, the typed *Operation* of every node gives
+/// its instruction, a promoted node is followed by INTEGER_TO_REAL. REAL literals are
+/// deduplicated in the constant pool. Expressions are walked without recursion (see
+/// *ExpressionWalker*), however deep they nest.
+class BytecodeCompiler : public AstVisitor<BytecodeCompiler>
+{
+public:
+    /// @note Throws if the analysis found errors
+    explicit BytecodeCompiler(const SemanticAnalyzer &analyzer);
+
+    BytecodeCompiler(const BytecodeCompiler &) = delete;
+    BytecodeCompiler &operator=(const BytecodeCompiler &) = delete;
+
+    BytecodeProgram compile();
+
+    // MARK: Handlers
+
+    void visit_block(BlockNode *node);
+    void visit_assignment_statement(AssignmentStatementNode *node);
+
+private:
+    const SemanticAnalyzer &analyzer_;
+    BytecodeProgram program_;
+    /// @brief Index in the constant pool of every REAL literal, by the bits of its value
+    std::unordered_map<std::uint64_t, std::uint32_t> real_indexes_;
+    std::size_t stack_depth_ = 0;
+    ExpressionWalker walker_;
+
+    void compile_expression(AstNode *node);
+    /// @brief Emit the instruction of *node*, after the code of its operands
+    void compile_node(AstNode *node);
+    void emit(Opcode opcode);
+    void emit(Opcode opcode, std::uint32_t operand);
+    /// @brief Account for an instruction pushing (positive) or popping (negative) values
+    void adjust_stack(int delta) noexcept;
+};
+
+/// @brief Print the instructions of *program*, one per line with its offset and operand
+/// (and the name of a variable or the value of a constant)
+void disassemble(const BytecodeProgram &program, std::ostream &os);
+
+#endif
@@ -0,0 +1,330 @@
+#include "char_scan.hpp"
+#include <cstddef>
+#include "token.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SCAN_HAS_SSE2 1
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SCAN_HAS_AVX2 1
+#endif
+
+// MARK: Scalar
+
+static inline bool is_ascii_digit(char c) noexcept
+{
+    return static_cast<unsigned char>(c - '0') <= 9;
+}
+
+static inline bool is_ascii_alnum(char c) noexcept
+{
+    return is_ascii_digit(c) || static_cast<unsigned char>((c | 0x20) - 'a') <= 'z' - 'a';
+}
+
+static std::size_t scalar_scan_whitespace(const char *data, std::size_t pos, std::size_t length) noexcept
+{
+    while (pos < length && is_whitespace(data[pos]))
+    {
+        pos++;
+    }
+    return pos;
+}
+
+static std::size_t scalar_scan_alnum(const char *data, std::size_t pos, std::size_t length) noexcept
+{
+    while (pos < length && is_ascii_alnum(data[pos]))
+    {
+        pos++;
+    }
+    return pos;
+}
+
+static std::size_t scalar_scan_digits(const char *data, std::size_t pos, std::size_t length) noexcept
+{
+    while (pos < length && is_ascii_digit(data[pos]))
+    {
+        pos++;
+    }
+    return pos;
+}
+
+static std::size_t scalar_find_char(const char *data, std::size_t pos, std::size_t length, char c) noexcept
+{
+    while (pos < length && data[pos] != c)
+    {
+        pos++;
+    }
+    return pos;
+}
+
+// MARK: SSE2
+
+#ifdef SCAN_HAS_SSE2
+
+/// @brief 0xFF in every lane where lo <= chunk <= lo + span (unsigned)
+static inline __m128i sse2_in_range(__m128i chunk, char lo, char span) noexcept
+{
+    __m128i shifted = _mm_sub_epi8(chunk, _mm_set1_epi8(lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(span)), shifted);
+}
+
+static inline __m128i sse2_whitespace(__m128i chunk) noexcept
+{
+    return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(kWhitespace)),
+                                     _mm_cmpeq_epi8(chunk, _mm_set1_epi8(kTab))),
+                        _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(kNewLine)),
+                                     _mm_cmpeq_epi8(chunk, _mm_set1_epi8(kCarriageReturn))));
+}
+
+static inline __m128i sse2_digit(__m128i chunk) noexcept
+{
+    return sse2_in_range(chunk, '0', 9);
+}
+
+static inline __m128i sse2_alnum(__m128i chunk) noexcept
+{
+    __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+    return _mm_or_si128(sse2_digit(chunk), sse2_in_range(lower, 'a', 'z' - 'a'));
+}
+
+/// @brief Run of lanes matching *classify* starting at pos
+template <__m128i (*classify)(__m128i), std::size_t (*scalar)(const char *, std::size_t, std::size_t)>
+static std::size_t sse2_scan(const char *data, std::size_t pos, std::size_t length) noexcept
+{
+    while (pos + 16 <= length)
+    {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+        unsigned outside = ~static_cast<unsigned>(_mm_movemask_epi8(classify(chunk))) & 0xFFFFu;
+        if (outside != 0)
+        {
+            return pos + __builtin_ctz(outside);
+        }
+        pos += 16;
+    }
+    return scalar(data, pos, length);
+}
+
+static std::size_t sse2_scan_whitespace(const char *data, std::size_t pos, std::size_t length) noexcept
+{
+    return sse2_scan<sse2_whitespace, scalar_scan_whitespace>(data, pos, length);
+}
+
+static std::size_t sse2_scan_alnum(const char *data, std::size_t pos, std::size_t length) noexcept
+{
+    return sse2_scan<sse2_alnum, scalar_scan_alnum>(data, pos, length);
+}
+
+static std::size_t sse2_scan_digits(const char *data, std::size_t pos, std::size_t length) noexcept
+{
+    return sse2_scan<sse2_digit, scalar_scan_digits>(data, pos, length);
+}
+
+static std::size_t sse2_find_char(const char *data, std::size_t pos, std::size_t length, char c) noexcept
+{
+    __m128i needle = _mm_set1_epi8(c);
+    while (pos + 16 <= length)
+    {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+        unsigned found = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+        if (found != 0)
+        {
+            return pos + __builtin_ctz(found);
+        }
+        pos += 16;
+    }
+    return scalar_find_char(data, pos, length, c);
+}
+
+#endif
+
+// MARK: AVX2
+
+#ifdef SCAN_HAS_AVX2
+
+#define SCAN_AVX2 __attribute__((target("avx2")))
+
+SCAN_AVX2 static inline __m256i avx2_in_range(__m256i chunk, char lo, char span) noexcept
+{
+    __m256i shifted = _mm256_sub_epi8(chunk, _mm256_set1_epi8(lo));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(span)), shifted);
+}
+
+SCAN_AVX2 static inline __m256i avx2_whitespace(__m256i chunk) noexcept
+{
+    return _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(kWhitespace)),
+                                           _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(kTab))),
+                           _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(kNewLine)),
+                                           _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(kCarriageReturn))));
+}
+
+SCAN_AVX2 static inline __m256i avx2_digit(__m256i chunk) noexcept
+{
+    return avx2_in_range(chunk, '0', 9);
+}
+
+SCAN_AVX2 static inline __m256i avx2_alnum(__m256i chunk) noexcept
+{
+    __m256i lower = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+    return _mm256_or_si256(avx2_digit(chunk), avx2_in_range(lower, 'a', 'z' - 'a'));
+}
+
+SCAN_AVX2 static std::size_t avx2_scan_whitespace(const char *data, std::size_t pos, std::size_t length) noexcept
+{
+    while (pos + 32 <= length)
+    {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+        unsigned outside = ~static_cast<unsigned>(_mm256_movemask_epi8(avx2_whitespace(chunk)));
+        if (outside != 0)
+        {
+            return pos + __builtin_ctz(outside);
+        }
+        pos += 32;
+    }
+    return sse2_scan_whitespace(data, pos, length);
+}
+
+SCAN_AVX2 static std::size_t avx2_scan_alnum(const char *data, std::size_t pos, std::size_t length) noexcept
+{
+    while (pos + 32 <= length)
+    {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+        unsigned outside = ~static_cast<unsigned>(_mm256_movemask_epi8(avx2_alnum(chunk)));
+        if (outside != 0)
+        {
+            return pos + __builtin_ctz(outside);
+        }
+        pos += 32;
+    }
+    return sse2_scan_alnum(data, pos, length);
+}
+
+SCAN_AVX2 static std::size_t avx2_scan_digits(const char *data, std::size_t pos, std::size_t length) noexcept
+{
+    while (pos + 32 <= length)
+    {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+        unsigned outside = ~static_cast<unsigned>(_mm256_movemask_epi8(avx2_digit(chunk)));
+        if (outside != 0)
+        {
+            return pos + __builtin_ctz(outside);
+        }
+        pos += 32;
+    }
+    return sse2_scan_digits(data, pos, length);
+}
+
+SCAN_AVX2 static std::size_t avx2_find_char(const char *data, std::size_t pos, std::size_t length, char c) noexcept
+{
+    __m256i needle = _mm256_set1_epi8(c);
+    while (pos + 32 <= length)
+    {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+        unsigned found = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+        if (found != 0)
+        {
+            return pos + __builtin_ctz(found);
+        }
+        pos += 32;
+    }
+    return sse2_find_char(data, pos, length, c);
+}
+
+#endif
+
+// MARK: Dispatch
+
+struct ScanKernels
+{
+    ScanBackend backend;
+    std::size_t (*scan_whitespace)(const char *, std::size_t, std::size_t);
+    std::size_t (*scan_alnum)(const char *, std::size_t, std::size_t);
+    std::size_t (*scan_digits)(const char *, std::size_t, std::size_t);
+    std::size_t (*find_char)(const char *, std::size_t, std::size_t, char);
+};
+
+static ScanKernels make_scan_kernels(ScanBackend backend) noexcept
+{
+    switch (backend)
+    {
+#ifdef SCAN_HAS_AVX2
+    case ScanBackend::AVX2:
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return {ScanBackend::AVX2, avx2_scan_whitespace, avx2_scan_alnum, avx2_scan_digits, avx2_find_char};
+        }
+        break;
+#endif
+#ifdef SCAN_HAS_SSE2
+    case ScanBackend::SSE2:
+        return {ScanBackend::SSE2, sse2_scan_whitespace, sse2_scan_alnum, sse2_scan_digits, sse2_find_char};
+#endif
+    default:
+        break;
+    }
+
+    return {ScanBackend::SCALAR, scalar_scan_whitespace, scalar_scan_alnum, scalar_scan_digits, scalar_find_char};
+}
+
+/// @note Function-local static, initialized on first use, after the CPU can be queried
+static ScanKernels &get_scan_kernels() noexcept
+{
+    static ScanKernels kernels = make_scan_kernels(detect_scan_backend());
+    return kernels;
+}
+
+ScanBackend detect_scan_backend() noexcept
+{
+#ifdef SCAN_HAS_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return ScanBackend::AVX2;
+    }
+#endif
+#ifdef SCAN_HAS_SSE2
+    return ScanBackend::SSE2;
+#else
+    return ScanBackend::SCALAR;
+#endif
+}
+
+ScanBackend get_scan_backend() noexcept { return get_scan_kernels().backend; }
+void set_scan_backend(ScanBackend backend) noexcept { get_scan_kernels() = make_scan_kernels(backend); }
+
+const char *map_scan_backend_to_string(ScanBackend backend) noexcept
+{
+    switch (backend)
+    {
+    case ScanBackend::SCALAR:
+        return "SCALAR";
+    case ScanBackend::SSE2:
+        return "SSE2";
+    case ScanBackend::AVX2:
+        return "AVX2";
+    default:
+        return "UNKNOWN SCAN BACKEND";
+    }
+}
+
+std::size_t scan_whitespace(const char *data, std::size_t pos, std::size_t length) noexcept
+{
+    return get_scan_kernels().scan_whitespace(data, pos, length);
+}
+
+std::size_t scan_alnum(const char *data, std::size_t pos, std::size_t length) noexcept
+{
+    return get_scan_kernels().scan_alnum(data, pos, length);
+}
+
+std::size_t scan_digits(const char *data, std::size_t pos, std::size_t length) noexcept
+{
+    return get_scan_kernels().scan_digits(data, pos, length);
+}
+
+std::size_t find_char(const char *data, std::size_t pos, std::size_t length, char c) noexcept
+{
+    return get_scan_kernels().find_char(data, pos, length, c);
+}
@@ -0,0 +1,40 @@
+#ifndef CHAR_SCAN_HPP
+#define CHAR_SCAN_HPP
+
+#include <cstddef>
+
+/// @brief Implementation used by the scanning functions below
+enum class ScanBackend : unsigned char
+{
+    /// @brief One byte at a time, available everywhere
+    SCALAR,
+    /// @brief 16 bytes at a time, baseline of every x86-64 CPU
+    SSE2,
+    /// @brief 32 bytes at a time, selected at runtime when the CPU supports it
+    AVX2
+};
+
+/// @brief Best backend supported by the running CPU
+ScanBackend detect_scan_backend() noexcept;
+/// @brief Backend currently in use, *detect_scan_backend()* unless overridden
+ScanBackend get_scan_backend() noexcept;
+/// @brief Force a backend (e.g. for benchmarking), falls back to *SCALAR* if the CPU does not support it
+/// @warning Not thread-safe, call it before any lexer runs
+void set_scan_backend(ScanBackend backend) noexcept;
+
+const char *map_scan_backend_to_string(ScanBackend backend) noexcept;
+
+/// @note Every function below looks at data[pos, length) and returns the position
+/// of the first character not belonging to the run, or *length* if the run reaches the end.
+/// Only ASCII characters are classified, bytes >= 0x80 never belong to a run.
+
+/// @brief Skip blanks, tabs and line breaks
+std::size_t scan_whitespace(const char *data, std::size_t pos, std::size_t length) noexcept;
+/// @brief Skip letters and digits
+std::size_t scan_alnum(const char *data, std::size_t pos, std::size_t length) noexcept;
+/// @brief Skip digits
+std::size_t scan_digits(const char *data, std::size_t pos, std::size_t length) noexcept;
+/// @brief Position of the first occurrence of *c*
+std::size_t find_char(const char *data, std::size_t pos, std::size_t length, char c) noexcept;
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef DIAGNOSTIC_HPP
+#define DIAGNOSTIC_HPP
+
+#include <cstdint>
+#include <string>
+
+/// @brief How the lexer and the parser react to an error in the source code
+enum class ErrorMode : unsigned char
+{
+    /// @brief Throw on the first error
+    THROW,
+    /// @brief Record every error as a *Diagnostic*, recover and go on
+    COLLECT
+};
+
+inline const char *map_error_mode_to_string(ErrorMode mode) noexcept
+{
+    return (mode == ErrorMode::COLLECT) ? "COLLECT" : "THROW";
+}
+
+enum class DiagnosticSeverity : unsigned char
+{
+    /// @brief The source code is still valid (e.g. a literal was clamped)
+    WARNING,
+    /// @brief The source code is invalid, what was built from it only serves diagnostics
+    ERROR
+};
+
+/// @brief Problem found in the source code, recorded instead of thrown
+class Diagnostic
+{
+public:
+    Diagnostic(std::uint32_t offset, std::string message, DiagnosticSeverity severity = DiagnosticSeverity::WARNING)
+        : offset_{offset}, message_{std::move(message)}, severity_{severity} {}
+
+    /// @brief Offset in the source code of the offending characters
+    std::uint32_t get_offset() const noexcept { return offset_; }
+    const std::string &get_message() const noexcept { return message_; }
+    DiagnosticSeverity get_severity() const noexcept { return severity_; }
+
+private:
+    std::uint32_t offset_;
+    std::string message_;
+    DiagnosticSeverity severity_;
+};
+
+inline const char *map_diagnostic_severity_to_string(DiagnosticSeverity severity) noexcept
+{
+    return (severity == DiagnosticSeverity::ERROR) ? "error" : "warning";
+}
+
+#endif
@@ -0,0 +1,23 @@
+#include "dispatch.hpp"
+#include <algorithm>
+#include <iterator>
+
+const char *map_dispatch_to_string(Dispatch dispatch) noexcept
+{
+    switch (dispatch)
+    {
+    case Dispatch::SWITCH:
+        return "SWITCH";
+    case Dispatch::THREADED:
+        return "THREADED";
+    default:
+        return "UNKNOWN DISPATCH";
+    }
+}
+
+DispatchTable make_dispatch_table(const void *const *handlers, std::size_t count, const void *invalid) noexcept
+{
+    DispatchTable table;
+    std::fill(std::copy(handlers, handlers + count, table.handlers), std::end(table.handlers), invalid);
+    return table;
+}
@@ -0,0 +1,93 @@
+#ifndef DISPATCH_HPP
+#define DISPATCH_HPP
+
+#include <climits>
+#include <cstddef>
+
+/// @brief Build flag choosing how the virtual machines dispatch their instructions,
+/// 1 for *Dispatch::THREADED*, 0 for *Dispatch::SWITCH*
+/// @note Threaded by default with GCC and Clang, override it with -DVM_THREADED_DISPATCH=0
+#ifndef VM_THREADED_DISPATCH
+#if defined(__GNUC__)
+#define VM_THREADED_DISPATCH 1
+#else
+#define VM_THREADED_DISPATCH 0
+#endif
+#endif
+
+/// @brief Implementation of the dispatch loop of the virtual machines
+enum class Dispatch : unsigned char
+{
+    /// @brief A switch in a loop, portable. Every instruction goes through
+    /// the same bounds check and the same hard to predict indirect jump.
+    SWITCH,
+    /// @brief Every handler jumps to the next one through a table of label addresses
+    /// (labels as values, a GCC/Clang extension). Each jump has its own branch
+    /// history, the predictor learns which instruction usually follows which.
+    THREADED
+};
+
+/// @brief Dispatch the virtual machines were built with
+constexpr Dispatch kDispatch = VM_THREADED_DISPATCH ? Dispatch::THREADED : Dispatch::SWITCH;
+
+const char *map_dispatch_to_string(Dispatch dispatch) noexcept;
+
+/// @brief Handler of every possible one-byte opcode, for *Dispatch::THREADED*
+struct DispatchTable
+{
+    const void *handlers[1 << CHAR_BIT];
+};
+
+/// @brief Table jumping to *handlers[opcode]* for the first *count* opcodes, and to
+/// *invalid* for every other byte
+DispatchTable make_dispatch_table(const void *const *handlers, std::size_t count, const void *invalid) noexcept;
+
+/// @note A dispatch loop is written once for both implementations:
+/// ```cpp
+/// #define VM_OPCODE Opcode
+/// #define VM_FETCH() static_cast<Opcode>(*ip++)
+/// VM_DISPATCH_TABLE(kOpcodeCount, &&INTEGER_PUSH, ..., &&HALT);
+/// VM_DISPATCH_BEGIN
+/// VM_CASE(HALT)
+///     return;
+/// VM_DEFAULT
+///     __THROW_EXECUTING_ERROR
+/// VM_DISPATCH_END
+/// ```
+/// *VM_OPCODE* is the opcode enum, *VM_FETCH()* reads the opcode of the next instruction
+/// and moves past it, and the table lists the address of the handler of each of the
+/// *count* opcodes, in the order of the enum. A handler ends with *VM_NEXT*, or leaves the loop.
+/// *VM_DEFAULT* handles an invalid opcode the same way in both implementations: threaded
+/// dispatch pads its table to the 256 values of a byte with it, so no jump leaves the table.
+#if VM_THREADED_DISPATCH
+
+#define VM_DISPATCH_TABLE(count, ...)                                                    \
+    static const void *const dispatch_handlers[] = {__VA_ARGS__};                        \
+    static_assert(sizeof(dispatch_handlers) / sizeof(*dispatch_handlers) == (count),     \
+                  "Every opcode needs a handler");                                       \
+    static_assert(sizeof(VM_OPCODE) == 1, "Opcodes must index a table of 256 handlers"); \
+    static const DispatchTable dispatch_table = make_dispatch_table(dispatch_handlers, (count), &&invalid_opcode)
+#define VM_DISPATCH_BEGIN VM_NEXT;
+#define VM_CASE(opcode) opcode:
+#define VM_NEXT goto *dispatch_table.handlers[static_cast<std::size_t>(VM_FETCH())]
+#define VM_DEFAULT invalid_opcode:
+#define VM_DISPATCH_END
+
+#else
+
+#define VM_DISPATCH_TABLE(count, ...)
+#define VM_DISPATCH_BEGIN   \
+    for (;;)                \
+    {                       \
+        switch (VM_FETCH()) \
+        {
+#define VM_CASE(opcode) case VM_OPCODE::opcode:
+#define VM_NEXT break
+#define VM_DEFAULT default:
+#define VM_DISPATCH_END \
+    }                   \
+    }
+
+#endif
+
+#endif
@@ -0,0 +1,468 @@
+#include "flat_ast.hpp"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include "ast.hpp"
+#include "ast_node.hpp"
+#include "ast_visitor.hpp"
+#include "token.hpp"
+
+const char *map_flat_ast_layout_to_string(FlatAstLayout layout) noexcept
+{
+    switch (layout)
+    {
+    case FlatAstLayout::TREE:
+        return "TREE";
+    case FlatAstLayout::DAG:
+        return "DAG";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+std::size_t FlatAst::get_footprint() const noexcept
+{
+    return columns_.node_count * (sizeof(AstNodeType) + sizeof(TokenType) + 2 * sizeof(std::uint32_t)) +
+           columns_.child_count * sizeof(NodeIndex) + columns_.real_count * sizeof(double) +
+           positions_.get_footprint();
+}
+
+NodeIndex FlatAst::add_node(AstNodeType kind, std::uint32_t first, std::uint32_t second, TokenType op)
+{
+    kinds_.push_back(kind);
+    operators_.push_back(op);
+    firsts_.push_back(first);
+    seconds_.push_back(second);
+    return static_cast<NodeIndex>(kinds_.size() - 1);
+}
+
+NodeIndex FlatAst::add_list_node(AstNodeType kind, const std::vector<NodeIndex> &children)
+{
+    NodeIndex first_child = static_cast<NodeIndex>(children_.size());
+    children_.insert(children_.end(), children.begin(), children.end());
+    return add_node(kind, first_child, static_cast<std::uint32_t>(children.size()));
+}
+
+/// @brief Identity of an expression node for hash-consing
+/// @note Children are identified by their (already shared) index, so equal keys mean
+/// structurally equal subtrees. A variable read is keyed by its symbol and the number of
+/// assignments to it so far, a real literal by the bits of its value.
+struct ExpressionKey
+{
+    AstNodeType kind;
+    TokenType op;
+    std::uint32_t first;
+    std::uint32_t second;
+
+    bool operator==(const ExpressionKey &other) const noexcept
+    {
+        return kind == other.kind && op == other.op && first == other.first && second == other.second;
+    }
+};
+
+struct ExpressionKeyHash
+{
+    std::size_t operator()(const ExpressionKey &key) const noexcept
+    {
+        std::uint64_t result = (static_cast<std::uint64_t>(key.first) << 32 | key.second) * 0x9e3779b97f4a7c15ull;
+        return static_cast<std::size_t>(result ^ (result >> 32) ^ static_cast<std::uint64_t>(key.kind) << 8 ^
+                                        static_cast<std::uint64_t>(key.op));
+    }
+};
+
+/// @brief Flattens a pointer-based tree, every handler returns the index of its node
+/// once its operands were flattened
+class FlatAstBuilder : public AstVisitor<FlatAstBuilder, NodeIndex>
+{
+public:
+    FlatAstBuilder(FlatAst &ast, FlatAstLayout layout) : ast_{ast}, sharing_{layout == FlatAstLayout::DAG} {}
+
+    /// @note Every node is added by its handler right before it returns,
+    /// its offset goes to the same index of the position table (a shared node adds nothing)
+    NodeIndex visit(AstNode *node) { return locate(node, AstVisitor::visit(node)); }
+
+    NodeIndex visit_program(ProgramNode *node)
+    {
+        NodeIndex block = visit(node->get_block_node());
+        return ast_.add_node(AstNodeType::PROGRAM, block, node->get_symbol());
+    }
+    NodeIndex visit_block(BlockNode *node)
+    {
+        std::vector<NodeIndex> children;
+        children.reserve(node->get_declaration_nodes().size() + 1);
+        for (VarDeclNode *declaration : node->get_declaration_nodes())
+        {
+            children.push_back(visit(declaration));
+        }
+        children.push_back(visit(node->get_compound_statement_node()));
+        return ast_.add_list_node(AstNodeType::BLOCK, children);
+    }
+    NodeIndex visit_compound_statement(CompoundStatementNode *node)
+    {
+        std::vector<NodeIndex> children;
+        children.reserve(node->get_statement_list().size());
+        for (AstNode *statement : node->get_statement_list())
+        {
+            children.push_back(visit(statement));
+        }
+        return ast_.add_list_node(AstNodeType::COMPOUND_STATEMENT, children);
+    }
+    NodeIndex visit_variable_declaration(VarDeclNode *node)
+    {
+        NodeIndex variable = visit_target(node->get_var_node());
+        NodeIndex type = visit(node->get_type_node());
+        return ast_.add_node(AstNodeType::VARIABLE_DECLARATION, variable, type);
+    }
+    NodeIndex visit_assignment_statement(AssignmentStatementNode *node)
+    {
+        NodeIndex variable = visit_target(node->get_lhs());
+        NodeIndex expression = visit(node->get_rhs());
+        /// @note Reads of the variable from now on see another value
+        if (sharing_)
+        {
+            SymbolId symbol = node->get_lhs()->get_symbol();
+            if (symbol >= assignment_counts_.size())
+            {
+                assignment_counts_.resize(symbol + 1, 0);
+            }
+            ++assignment_counts_[symbol];
+        }
+        return ast_.add_node(AstNodeType::ASSIGNMENT_STATEMENT, variable, expression);
+    }
+    NodeIndex visit_binary_operator(BinaryOperatorNode *node) { return flatten_expression(node); }
+    NodeIndex visit_unary_operator(UnaryOperatorNode *node) { return flatten_expression(node); }
+    NodeIndex visit_variable(VariableNode *node)
+    {
+        SymbolId symbol = node->get_symbol();
+        std::uint32_t assignment_count = (symbol < assignment_counts_.size()) ? assignment_counts_[symbol] : 0;
+        ExpressionKey key{AstNodeType::VARIABLE, TokenType::END_OF_FILE, symbol, assignment_count};
+        NodeIndex shared = find_shared(key);
+        return (shared != kNoNode) ? shared : remember(key, ast_.add_node(AstNodeType::VARIABLE, symbol));
+    }
+    NodeIndex visit_type(TypeNode *node)
+    {
+        return ast_.add_node(AstNodeType::TYPE, kNoNode, kNoNode, node->get_token()->get_type());
+    }
+    NodeIndex visit_int_num(IntNumNode *node)
+    {
+        std::uint32_t value = static_cast<std::uint32_t>(node->get_token()->get_value());
+        ExpressionKey key{AstNodeType::INT_NUM, TokenType::END_OF_FILE, value, kNoNode};
+        NodeIndex shared = find_shared(key);
+        return (shared != kNoNode) ? shared : remember(key, ast_.add_node(AstNodeType::INT_NUM, value));
+    }
+    NodeIndex visit_real_num(RealNumNode *node)
+    {
+        double value = node->get_token()->get_value();
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        ExpressionKey key{AstNodeType::REAL_NUM, TokenType::END_OF_FILE, static_cast<std::uint32_t>(bits),
+                          static_cast<std::uint32_t>(bits >> 32)};
+        NodeIndex shared = find_shared(key);
+        if (shared != kNoNode)
+        {
+            return shared;
+        }
+        ast_.reals_.push_back(value);
+        return remember(key, ast_.add_node(AstNodeType::REAL_NUM, static_cast<std::uint32_t>(ast_.reals_.size() - 1)));
+    }
+    NodeIndex visit_no_operation(NoOperationNode *)
+    {
+        return ast_.add_node(AstNodeType::NO_OPERATION);
+    }
+    NodeIndex visit_error(ErrorNode *)
+    {
+        return ast_.add_node(AstNodeType::ERROR);
+    }
+
+private:
+    FlatAst &ast_;
+    /// @brief Expression nodes are shared (*FlatAstLayout::DAG*)
+    bool sharing_;
+    /// @brief Expression nodes added so far, by identity
+    std::unordered_map<ExpressionKey, NodeIndex, ExpressionKeyHash> shared_nodes_;
+    /// @brief Number of assignments to every symbol so far
+    std::vector<std::uint32_t> assignment_counts_;
+    ExpressionWalker walker_;
+    /// @brief Indexes of the operands flattened by *flatten_expression()* and not used yet
+    std::vector<NodeIndex> operands_;
+
+    /// @brief Give *index*, the node just flattened from *node*, the offset of *node*
+    /// (a shared node was added and located before)
+    NodeIndex locate(AstNode *node, NodeIndex index)
+    {
+        if (ast_.positions_.size() < ast_.kinds_.size())
+        {
+            ast_.positions_.push_back(node->get_offset());
+        }
+        return index;
+    }
+    /// @brief Flatten the expression *node* in post-order, without recursion
+    NodeIndex flatten_expression(AstNode *node)
+    {
+        operands_.clear();
+        walker_.walk(node, [this](AstNode *node) {
+            switch (node->get_type())
+            {
+            case AstNodeType::BINARY_OPERATOR:
+            {
+                NodeIndex rhs = operands_.back();
+                operands_.pop_back();
+                NodeIndex index = add_operator(AstNodeType::BINARY_OPERATOR, node, operands_.back(), rhs);
+                operands_.back() = locate(node, index);
+                break;
+            }
+            case AstNodeType::UNARY_OPERATOR:
+            {
+                NodeIndex index = add_operator(AstNodeType::UNARY_OPERATOR, node, operands_.back(), kNoNode);
+                operands_.back() = locate(node, index);
+                break;
+            }
+            default:
+                /// @note A leaf, visiting it does not recurse
+                operands_.push_back(visit(node));
+                break;
+            }
+        });
+        return operands_.back();
+    }
+    /// @brief Add the operator *node* over its operands, already flattened, unless an equal one is shared
+    NodeIndex add_operator(AstNodeType kind, AstNode *node, NodeIndex first, NodeIndex second)
+    {
+        TokenType op = static_cast<TokenHolderNode<Token> *>(node)->get_token()->get_type();
+        ExpressionKey key{kind, op, first, second};
+        NodeIndex shared = find_shared(key);
+        return (shared != kNoNode) ? shared : remember(key, ast_.add_node(kind, first, second, op));
+    }
+
+    /// @brief Node added before with the identity *key*, or kNoNode (always when not sharing)
+    NodeIndex find_shared(const ExpressionKey &key) const
+    {
+        if (!sharing_)
+        {
+            return kNoNode;
+        }
+        auto position = shared_nodes_.find(key);
+        return (position != shared_nodes_.end()) ? position->second : kNoNode;
+    }
+    /// @brief Share *node*, just added with the identity *key*, with the next equal expressions
+    NodeIndex remember(const ExpressionKey &key, NodeIndex node)
+    {
+        if (sharing_)
+        {
+            shared_nodes_.emplace(key, node);
+        }
+        return node;
+    }
+    /// @brief Flatten a variable being declared or assigned, which is not a read and is never shared
+    NodeIndex visit_target(VariableNode *node)
+    {
+        bool sharing = sharing_;
+        sharing_ = false;
+        NodeIndex index = visit(node);
+        sharing_ = sharing;
+        return index;
+    }
+};
+
+FlatAst::FlatAst(AbstractSyntaxTree *ast, FlatAstLayout layout) : interner_{ast->get_interner()}
+{
+    FlatAstBuilder builder(*this, layout);
+    builder.visit(ast->get_root());
+
+    columns_ = Columns{kinds_.data(), operators_.data(), firsts_.data(), seconds_.data(), children_.data(),
+                       reals_.data(), kinds_.size(), children_.size(), reals_.size()};
+}
+
+/// @brief Rebuilds the pointer-based tree of a *FlatAst*, top-down from the root
+/// @note Operators are rebuilt over an explicit stack (expressions nest 100k deep), a shared
+/// operand is walked again, and copied, for every use
+class TreeBuilder
+{
+public:
+    TreeBuilder(const FlatAst &ast, AbstractSyntaxTree *tree)
+        : ast_{ast}, arena_{tree->get_arena()}, offsets_{ast.get_positions().decode()} {}
+
+    AstNode *build(NodeIndex node)
+    {
+        AstNodeType kind = ast_.get_kind(node);
+        if (kind == AstNodeType::BINARY_OPERATOR || kind == AstNodeType::UNARY_OPERATOR)
+        {
+            return build_expression(node);
+        }
+        return locate(create(node), node);
+    }
+
+private:
+    struct Frame
+    {
+        NodeIndex node;
+        /// @brief Its operands were pushed, the node is created the next time it is popped
+        bool expanded;
+    };
+
+    const FlatAst &ast_;
+    Arena &arena_;
+    std::vector<std::uint32_t> offsets_;
+    std::vector<Frame> frames_;
+    /// @brief Operands built by *build_expression()* and not used yet
+    std::vector<AstNode *> operands_;
+
+    AstNode *locate(AstNode *result, NodeIndex node)
+    {
+        result->set_offset(offsets_[node]);
+        return result;
+    }
+
+    /// @brief Build the expression *root* in post-order: leaves are created by *build()*
+    /// (the tree was validated, they have no operands), operators over the operands built last
+    AstNode *build_expression(NodeIndex root)
+    {
+        frames_.clear();
+        operands_.clear();
+        frames_.push_back(Frame{root, false});
+        while (!frames_.empty())
+        {
+            Frame frame = frames_.back();
+            frames_.pop_back();
+            NodeIndex node = frame.node;
+            switch (ast_.get_kind(node))
+            {
+            case AstNodeType::BINARY_OPERATOR:
+                if (!frame.expanded)
+                {
+                    frames_.push_back(Frame{node, true});
+                    frames_.push_back(Frame{ast_.get_second(node), false});
+                    frames_.push_back(Frame{ast_.get_first(node), false});
+                }
+                else
+                {
+                    AstNode *rhs = operands_.back();
+                    operands_.pop_back();
+                    operands_.back() = locate(
+                        arena_.create<BinaryOperatorNode>(arena_.create<Token>(ast_.get_operator(node)),
+                                                          operands_.back(), rhs),
+                        node);
+                }
+                break;
+            case AstNodeType::UNARY_OPERATOR:
+                if (!frame.expanded)
+                {
+                    frames_.push_back(Frame{node, true});
+                    frames_.push_back(Frame{ast_.get_first(node), false});
+                }
+                else
+                {
+                    operands_.back() = locate(
+                        arena_.create<UnaryOperatorNode>(arena_.create<Token>(ast_.get_operator(node)),
+                                                         operands_.back()),
+                        node);
+                }
+                break;
+            default:
+                operands_.push_back(build(node));
+                break;
+            }
+        }
+        return operands_.back();
+    }
+
+    AstNode *create(NodeIndex node)
+    {
+        switch (ast_.get_kind(node))
+        {
+        case AstNodeType::PROGRAM:
+            return arena_.create<ProgramNode>(ast_.get_symbol(node),
+                                              static_cast<BlockNode *>(build(ast_.get_first(node))));
+        case AstNodeType::BLOCK:
+        {
+            /// @note Declarations, then the compound statement
+            std::size_t declaration_count = ast_.get_child_count(node) - 1;
+            std::vector<VarDeclNode *> declarations(declaration_count);
+            for (std::size_t i = 0; i < declaration_count; ++i)
+            {
+                declarations[i] = static_cast<VarDeclNode *>(build(ast_.get_children(node)[i]));
+            }
+            CompoundStatementNode *compound_statement =
+                static_cast<CompoundStatementNode *>(build(ast_.get_children(node)[declaration_count]));
+            return arena_.create<BlockNode>(arena_.copy_array(declarations.data(), declaration_count),
+                                            declaration_count, compound_statement);
+        }
+        case AstNodeType::COMPOUND_STATEMENT:
+        {
+            std::vector<AstNode *> statements(ast_.get_child_count(node));
+            for (std::size_t i = 0; i < statements.size(); ++i)
+            {
+                statements[i] = build(ast_.get_children(node)[i]);
+            }
+            return arena_.create<CompoundStatementNode>(arena_.copy_array(statements.data(), statements.size()),
+                                                        statements.size());
+        }
+        case AstNodeType::VARIABLE_DECLARATION:
+            return arena_.create<VarDeclNode>(static_cast<VariableNode *>(build(ast_.get_first(node))),
+                                              static_cast<TypeNode *>(build(ast_.get_second(node))));
+        case AstNodeType::ASSIGNMENT_STATEMENT:
+            return arena_.create<AssignmentStatementNode>(static_cast<VariableNode *>(build(ast_.get_first(node))),
+                                                          build(ast_.get_second(node)));
+        case AstNodeType::VARIABLE:
+            if (ast_.get_symbol(node) == kInvalidSymbol)
+            {
+                __THROW_REBUILDING_AST_ERROR
+            }
+            return arena_.create<VariableNode>(ast_.get_symbol(node));
+        case AstNodeType::TYPE:
+            return arena_.create<TypeNode>(arena_.create<Token>(ast_.get_operator(node)));
+        case AstNodeType::INT_NUM:
+            return arena_.create<IntNumNode>(arena_.create<IntNumToken>(ast_.get_int_value(node)));
+        case AstNodeType::REAL_NUM:
+            return arena_.create<RealNumNode>(arena_.create<RealNumToken>(ast_.get_real_value(node)));
+        case AstNodeType::NO_OPERATION:
+            return arena_.create<NoOperationNode>();
+        case AstNodeType::ERROR:
+            return arena_.create<ErrorNode>();
+        default:
+            __THROW_REBUILDING_AST_ERROR
+        }
+    }
+};
+
+AbstractSyntaxTree *FlatAst::to_tree() const
+{
+    /// @note Size of every subtree once shared nodes are copied, a few shared
+    /// nodes can stand for an exponentially larger tree
+    std::vector<std::uint64_t> sizes(get_node_count());
+    for (NodeIndex node = 0; node < get_node_count(); ++node)
+    {
+        std::uint64_t size = 1;
+        switch (get_kind(node))
+        {
+        case AstNodeType::BLOCK:
+        case AstNodeType::COMPOUND_STATEMENT:
+            for (std::size_t i = 0; i < get_child_count(node); ++i)
+            {
+                size = std::min<std::uint64_t>(size + sizes[get_children(node)[i]], kNoNode);
+            }
+            break;
+        case AstNodeType::PROGRAM:
+        case AstNodeType::UNARY_OPERATOR:
+            size += sizes[get_first(node)];
+            break;
+        case AstNodeType::VARIABLE_DECLARATION:
+        case AstNodeType::ASSIGNMENT_STATEMENT:
+        case AstNodeType::BINARY_OPERATOR:
+            size += sizes[get_first(node)] + sizes[get_second(node)];
+            break;
+        default:
+            break;
+        }
+        sizes[node] = std::min<std::uint64_t>(size, kNoNode);
+    }
+    if (sizes[get_root()] >= kNoNode)
+    {
+        __THROW_REBUILDING_AST_ERROR
+    }
+
+    std::unique_ptr<AbstractSyntaxTree> tree(new AbstractSyntaxTree(interner_));
+    TreeBuilder builder(*this, tree.get());
+    tree->set_root(static_cast<ProgramNode *>(builder.build(get_root())));
+    return tree.release();
+}
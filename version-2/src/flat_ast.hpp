@@ -0,0 +1,160 @@
+#ifndef FLAT_AST_HPP
+#define FLAT_AST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "ast.hpp"
+#include "ast_node.hpp"
+#include "interner.hpp"
+#include "position_table.hpp"
+#include "token.hpp"
+
+#define __THROW_REBUILDING_AST_ERROR \
+    throw std::runtime_error("Error rebuilding AST");
+
+/// @brief Index of a node in a *FlatAst*
+using NodeIndex = std::uint32_t;
+
+/// @brief Marks a missing node
+constexpr NodeIndex kNoNode = UINT32_MAX;
+
+/// @brief How a *FlatAst* lays out the nodes of a tree
+enum class FlatAstLayout : unsigned char
+{
+    /// @brief One flat node per node of the tree
+    TREE,
+    /// @brief Identical pure subexpressions (operators over the same operands, literals,
+    /// reads of a variable not assigned in between) are stored once and shared by every
+    /// user, turning the tree into a DAG (hash-consing)
+    /// @note A storage layout, the *RegisterCompiler* shares the same subexpressions
+    /// of the code it generates
+    DAG
+};
+
+const char *map_flat_ast_layout_to_string(FlatAstLayout layout) noexcept;
+
+/// @brief AST stored as parallel arrays (structure of arrays) indexed by *NodeIndex*.
+/// @note Nodes are laid out in post-order: operands always come before the node using
+/// them and the root is the last node, so bottom-up passes (evaluation, type checking, ...)
+/// are a single forward scan over the arrays. A node takes 10 bytes (kind, operator and two
+/// 32-bit fields) plus 4 bytes per child of a list node and 8 bytes per real literal, instead
+/// of a heap object with a vtable, pointers and a separately allocated token.
+///
+/// Fields of every kind:
+/// | kind                 | operator     | first              | second          |
+/// |----------------------|--------------|--------------------|-----------------|
+/// | PROGRAM              |              | block              | symbol          |
+/// | BLOCK                |              | first child (*)    | child count (*) |
+/// | COMPOUND_STATEMENT   |              | first child (*)    | child count (*) |
+/// | VARIABLE_DECLARATION |              | variable           | type            |
+/// | ASSIGNMENT_STATEMENT |              | variable           | expression      |
+/// | BINARY_OPERATOR      | operator     | lhs                | rhs             |
+/// | UNARY_OPERATOR       | operator     | operand            |                 |
+/// | VARIABLE             |              | symbol             |                 |
+/// | TYPE                 | type keyword |                    |                 |
+/// | INT_NUM              |              | value              |                 |
+/// | REAL_NUM             |              | index of the value |                 |
+/// | ERROR                |              |                    |                 |
+/// (*) Position in *get_children()*, the children of a BLOCK are its declarations followed
+/// by its compound statement.
+///
+/// The source offset of every node is kept aside in a delta-encoded *PositionTable*,
+/// about a byte per node instead of four.
+///
+/// With *FlatAstLayout::DAG* an expression node may have several users, the post-order
+/// still holds (a shared node comes before all of them) and a forward scan evaluates it once.
+/// The whole program is a single straight-line region (the language has no control flow),
+/// a read of a variable is shared up to the next assignment to that variable.
+class FlatAst
+{
+public:
+    /// @brief Flatten a pointer-based tree
+    explicit FlatAst(AbstractSyntaxTree *ast, FlatAstLayout layout = FlatAstLayout::TREE);
+
+    /// @note The arrays are not copied, see *AstFile* to persist a tree
+    FlatAst(const FlatAst &) = delete;
+    FlatAst &operator=(const FlatAst &) = delete;
+
+    std::size_t get_node_count() const noexcept { return columns_.node_count; }
+    NodeIndex get_root() const noexcept { return static_cast<NodeIndex>(columns_.node_count - 1); }
+    /// @brief Interner resolving the symbols of VARIABLE and PROGRAM nodes
+    const std::shared_ptr<Interner> &get_interner() const noexcept { return interner_; }
+
+    AstNodeType get_kind(NodeIndex node) const noexcept { return columns_.kinds[node]; }
+    NodeIndex get_first(NodeIndex node) const noexcept { return columns_.firsts[node]; }
+    NodeIndex get_second(NodeIndex node) const noexcept { return columns_.seconds[node]; }
+
+    /// @brief Children of a BLOCK or COMPOUND_STATEMENT node
+    const NodeIndex *get_children(NodeIndex node) const noexcept { return columns_.children + columns_.firsts[node]; }
+    std::size_t get_child_count(NodeIndex node) const noexcept { return columns_.seconds[node]; }
+
+    /// @brief Symbol of a VARIABLE or PROGRAM node
+    SymbolId get_symbol(NodeIndex node) const noexcept
+    {
+        return (columns_.kinds[node] == AstNodeType::PROGRAM) ? columns_.seconds[node] : columns_.firsts[node];
+    }
+    /// @brief Operator of a BINARY_OPERATOR / UNARY_OPERATOR node, keyword of a TYPE node
+    TokenType get_operator(NodeIndex node) const noexcept { return columns_.operators[node]; }
+    int get_int_value(NodeIndex node) const noexcept { return static_cast<int>(columns_.firsts[node]); }
+    double get_real_value(NodeIndex node) const noexcept { return columns_.reals[columns_.firsts[node]]; }
+    /// @brief Offset in the source code of the token the node was built from
+    /// (the first occurrence of a shared node)
+    /// @note Decodes up to *PositionTable::kCheckpointInterval* deltas, meant for
+    /// diagnostics and profiles rather than hot loops
+    std::uint32_t get_offset(NodeIndex node) const noexcept { return positions_[node]; }
+    const PositionTable &get_positions() const noexcept { return positions_; }
+
+    /// @brief Bytes used by the arrays of nodes and children, and by the position table
+    std::size_t get_footprint() const noexcept;
+
+    /// @brief Rebuild the pointer-based tree, for the passes that walk one (analysis, compilers)
+    /// @note A node shared by a DAG is copied for each of its users, the analysis annotates
+    /// every use on its own. Throws if the tree would exceed *kNoNode* nodes, or reads
+    /// a variable without a name.
+    AbstractSyntaxTree *to_tree() const;
+
+private:
+    /// @brief Arrays read by the accessors, either the storage below or a mapped *AstFile*
+    struct Columns
+    {
+        const AstNodeType *kinds;
+        const TokenType *operators;
+        const std::uint32_t *firsts;
+        const std::uint32_t *seconds;
+        const NodeIndex *children;
+        const double *reals;
+        std::size_t node_count;
+        std::size_t child_count;
+        std::size_t real_count;
+    };
+
+    /// @brief Storage of a flattened tree, empty when the tree was loaded from an *AstFile*
+    std::vector<AstNodeType> kinds_;
+    std::vector<TokenType> operators_;
+    std::vector<std::uint32_t> firsts_;
+    std::vector<std::uint32_t> seconds_;
+    std::vector<NodeIndex> children_;
+    std::vector<double> reals_;
+
+    Columns columns_;
+    PositionTable positions_;
+    std::shared_ptr<Interner> interner_;
+    /// @brief Keeps the columns of a loaded tree alive, nullptr for a flattened tree
+    std::shared_ptr<const void> mapping_;
+
+    /// @brief Empty tree, filled by *AstFile::load()*
+    FlatAst() = default;
+
+    NodeIndex add_node(AstNodeType kind, std::uint32_t first = kNoNode, std::uint32_t second = kNoNode,
+                       TokenType op = TokenType::END_OF_FILE);
+    /// @brief Append the children of a list node (already flattened) to *children_*
+    NodeIndex add_list_node(AstNodeType kind, const std::vector<NodeIndex> &children);
+
+    friend class FlatAstBuilder;
+    friend class AstFile;
+};
+
+#endif
@@ -0,0 +1,289 @@
+#include "incremental.hpp"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "ast_node.hpp"
+#include "lexer.hpp"
+#include "token.hpp"
+
+/// @brief Whether both tokens hold the same value, regardless of their offsets
+static bool is_same_token(const BufferedToken &lhs, const BufferedToken &rhs) noexcept
+{
+    if (lhs.get_type() != rhs.get_type())
+    {
+        return false;
+    }
+
+    switch (lhs.get_type())
+    {
+    case TokenType::ID:
+        return lhs.get_symbol() == rhs.get_symbol();
+    case TokenType::INTEGER_NUMBER:
+        return lhs.get_int_value() == rhs.get_int_value();
+    case TokenType::REAL_NUMBER:
+    {
+        /// @note Bitwise, so that e.g. 0.0 and -0.0 differ
+        double lhs_value = lhs.get_real_value();
+        double rhs_value = rhs.get_real_value();
+        return std::memcmp(&lhs_value, &rhs_value, sizeof(double)) == 0;
+    }
+    default:
+        return true;
+    }
+}
+
+IncrementalDocument::IncrementalDocument(std::string source)
+    : source_{std::move(source)}, tokens_{SourceView(), nullptr}
+{
+    relex_program();
+    reparse_program();
+}
+
+SourceView IncrementalDocument::get_source_view() const noexcept
+{
+    return SourceView(source_.data(), source_.length());
+}
+
+void IncrementalDocument::relex_program()
+{
+    tokens_up_to_date_ = false;
+
+    Lexer lexer(get_source_view());
+    lexer.set_interner(interner_);
+    tokens_ = lexer.tokenize();
+
+    tokens_up_to_date_ = true;
+}
+
+void IncrementalDocument::reparse_program()
+{
+    ast_up_to_date_ = false;
+
+    std::vector<StatementSpan> spans;
+    Parser parser(&tokens_);
+    parser.set_statement_spans(&spans);
+    ast_.reset(parser.parse());
+    spans_ = std::move(spans);
+
+    ast_up_to_date_ = true;
+}
+
+void IncrementalDocument::replace_node(const StatementSpan &span, AstNode *node) noexcept
+{
+    if (span.parent == kNoParentSpan)
+    {
+        /// @note Only the compound statement of the block has no parent
+        ast_->get_root()->get_block_node()->replace_compound_statement_node(static_cast<CompoundStatementNode *>(node));
+        return;
+    }
+    static_cast<CompoundStatementNode *>(spans_[span.parent].node)->replace_statement(span.index, node);
+}
+
+EditSummary IncrementalDocument::edit(std::size_t offset, std::size_t removed_length, const std::string &inserted)
+{
+    source_.replace(offset, removed_length, inserted);
+    tokens_.set_source(get_source_view());
+
+    EditSummary summary;
+    if (!tokens_up_to_date_)
+    {
+        relex_program();
+        reparse_program();
+        summary.relexed_token_count = tokens_.size();
+        summary.reparsed_token_count = tokens_.size();
+        summary.full_reparse = true;
+        return summary;
+    }
+
+    std::size_t first_token;
+    std::size_t end_token;
+    std::vector<BufferedToken> tokens;
+    try
+    {
+        relex(offset, removed_length, inserted.length(), first_token, end_token, tokens);
+    }
+    catch (...)
+    {
+        tokens_up_to_date_ = false;
+        ast_up_to_date_ = false;
+        throw;
+    }
+    summary.relexed_token_count = tokens.size();
+
+    bool same_tokens = (tokens.size() == end_token - first_token);
+    for (std::size_t i = 0; same_tokens && i < tokens.size(); ++i)
+    {
+        same_tokens = is_same_token(tokens[i], tokens_[first_token + i]);
+    }
+    tokens_.splice(first_token, end_token, tokens);
+
+    if (same_tokens && ast_up_to_date_)
+    {
+        /// @note Only whitespace, comments or token positions changed, the AST stays valid
+        return summary;
+    }
+
+    if (ast_up_to_date_)
+    {
+        summary.reparsed_token_count = reparse(first_token, end_token, tokens.size());
+        if (summary.reparsed_token_count > 0)
+        {
+            return summary;
+        }
+    }
+
+    reparse_program();
+    summary.reparsed_token_count = tokens_.size();
+    summary.full_reparse = true;
+    return summary;
+}
+
+void IncrementalDocument::relex(std::size_t offset, std::size_t removed_length, std::size_t inserted_length,
+                                std::size_t &first_token, std::size_t &end_token, std::vector<BufferedToken> &tokens)
+{
+    std::uint32_t delta = static_cast<std::uint32_t>(inserted_length - removed_length);
+    std::size_t old_edit_end = offset + removed_length;
+
+    /// @note The token right before the edit may grow into it (e.g. typing at the end of
+    /// an identifier), re-lexing starts at its first character
+    std::size_t token_count = tokens_.size();
+    std::size_t before = 0;
+    std::size_t after = token_count;
+    while (before < after)
+    {
+        std::size_t middle = before + (after - before) / 2;
+        if (tokens_[middle].get_offset() < offset)
+        {
+            before = middle + 1;
+        }
+        else
+        {
+            after = middle;
+        }
+    }
+    first_token = (before > 0) ? before - 1 : 0;
+    std::size_t restart = (before > 0) ? tokens_[first_token].get_offset() : 0;
+
+    /// @note Only an old token starting past the removed text can resynchronize
+    end_token = before;
+    while (end_token < token_count && tokens_[end_token].get_offset() < old_edit_end)
+    {
+        ++end_token;
+    }
+
+    Lexer lexer(SourceView(source_.data() + restart, source_.length() - restart), restart);
+    lexer.set_interner(interner_);
+    for (;;)
+    {
+        BufferedToken token = lexer.scan();
+        std::uint32_t token_offset = token.get_offset();
+        while (end_token < token_count && tokens_[end_token].get_offset() + delta < token_offset)
+        {
+            ++end_token;
+        }
+
+        if (end_token < token_count && tokens_[end_token].get_offset() + delta == token_offset)
+        {
+            break;
+        }
+        tokens.push_back(token);
+    }
+
+    for (std::size_t i = end_token; i < token_count; ++i)
+    {
+        BufferedToken &token = tokens_[i];
+        token.set_offset(token.get_offset() + delta);
+    }
+
+    /// @note The token before the edit is damaged only if it grew into it, otherwise
+    /// the damage starts at the first token intersecting the edit (e.g. the first token
+    /// of a statement, not the `;` before it)
+    if (first_token < before && !tokens.empty() && tokens[0].get_offset() == tokens_[first_token].get_offset() &&
+        is_same_token(tokens[0], tokens_[first_token]))
+    {
+        tokens.erase(tokens.begin());
+        ++first_token;
+    }
+}
+
+std::size_t IncrementalDocument::reparse(std::size_t first_token, std::size_t end_token, std::size_t token_count)
+{
+    std::size_t token_delta = token_count - (end_token - first_token);
+
+    /// @note Innermost candidate: the last span starting at or before the damage,
+    /// enclosing spans are then reached through the parents
+    auto starts_after = std::upper_bound(spans_.begin(), spans_.end(), first_token,
+                                         [](std::size_t token, const StatementSpan &span) { return token < span.first_token; });
+    std::size_t span_index = static_cast<std::size_t>(starts_after - spans_.begin());
+    span_index = (span_index > 0) ? span_index - 1 : kNoParentSpan;
+
+    Parser parser(&tokens_);
+    std::vector<StatementSpan> spans;
+    parser.set_statement_spans(&spans);
+    for (; span_index != kNoParentSpan; span_index = spans_[span_index].parent)
+    {
+        StatementSpan span = spans_[span_index];
+        if (span.first_token > first_token || span.end_token < end_token || span.first_token == span.end_token)
+        {
+            continue;
+        }
+
+        AstNode *node;
+        spans.clear();
+        try
+        {
+            node = parser.parse_statement(span.first_token, &ast_->get_arena());
+        }
+        catch (const std::runtime_error &)
+        {
+            continue;
+        }
+
+        std::size_t new_end_token = span.end_token + token_delta;
+        if (parser.get_token_index() != new_end_token)
+        {
+            continue;
+        }
+
+        replace_node(span, node);
+
+        /// @note Replace the spans of the old statement and of everything nested in it
+        std::size_t old_span_end = span_index + 1;
+        while (old_span_end < spans_.size() && spans_[old_span_end].first_token < span.end_token)
+        {
+            ++old_span_end;
+        }
+        std::size_t span_delta = spans.size() - (old_span_end - span_index);
+
+        for (StatementSpan &new_span : spans)
+        {
+            new_span.parent = (new_span.parent == kNoParentSpan) ? span.parent : new_span.parent + span_index;
+        }
+        spans[0].index = span.index;
+
+        for (std::size_t i = 0; i < span_index; ++i)
+        {
+            /// @note Only the enclosing statements end after the old statement
+            if (spans_[i].end_token >= span.end_token)
+            {
+                spans_[i].end_token += token_delta;
+            }
+        }
+        for (std::size_t i = old_span_end; i < spans_.size(); ++i)
+        {
+            StatementSpan &later_span = spans_[i];
+            later_span.first_token += token_delta;
+            later_span.end_token += token_delta;
+            if (later_span.parent != kNoParentSpan && later_span.parent > span_index)
+            {
+                later_span.parent += span_delta;
+            }
+        }
+
+        spans_.erase(spans_.begin() + span_index, spans_.begin() + old_span_end);
+        spans_.insert(spans_.begin() + span_index, spans.begin(), spans.end());
+        return new_end_token - span.first_token;
+    }
+
+    return 0;
+}
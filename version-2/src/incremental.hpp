@@ -0,0 +1,86 @@
+#ifndef INCREMENTAL_HPP
+#define INCREMENTAL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ast.hpp"
+#include "interner.hpp"
+#include "parser.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Work done by *IncrementalDocument::edit()*
+struct EditSummary
+{
+    /// @brief Tokens produced by re-lexing the damaged range
+    std::size_t relexed_token_count = 0;
+    /// @brief Tokens covered by the re-parsed statement (all of them on a full re-parse,
+    /// none when the edit left every token value untouched, e.g. in whitespace or comments)
+    std::size_t reparsed_token_count = 0;
+    bool full_reparse = false;
+};
+
+/// @brief Program kept tokenized and parsed across small text edits.
+/// @note An edit re-lexes from the token before the edit until a new token starts where
+/// an old token past the edit started (shifted by the edit), since the lexer always restarts
+/// from the same state at a token boundary. Only the smallest statement enclosing the changed
+/// tokens is then re-parsed, and it is accepted only if it ends exactly where the old one did;
+/// otherwise the enclosing statements are tried, up to the compound statement of the block
+/// (e.g. when a statement is inserted or deleted), and then the whole program. Every other
+/// subtree of the AST is kept as is.
+/// Token offsets and statement spans after the edit are shifted, which is linear in the size of
+/// the program but only touches plain arrays.
+/// @note Replaced statements stay in the arena of the AST until the next full re-parse.
+class IncrementalDocument
+{
+public:
+    /// @note Throws like *Lexer* and *Parser* if *source* is not a valid program
+    explicit IncrementalDocument(std::string source);
+
+    IncrementalDocument(const IncrementalDocument &) = delete;
+    IncrementalDocument &operator=(const IncrementalDocument &) = delete;
+
+    /// @brief Replace *removed_length* characters at *offset* with *inserted*
+    /// @note The text is always edited. If the edited program does not tokenize or parse,
+    /// the error is rethrown and the AST stays the one of the last valid program,
+    /// the next edit then re-lexes and/or re-parses everything.
+    EditSummary edit(std::size_t offset, std::size_t removed_length, const std::string &inserted);
+
+    const std::string &get_source() const noexcept { return source_; }
+    const TokenBuffer &get_tokens() const noexcept { return tokens_; }
+    /// @brief AST of the last valid program
+    AbstractSyntaxTree *get_ast() const noexcept { return ast_.get(); }
+    /// @brief Whether the AST matches the current source
+    bool is_ast_up_to_date() const noexcept { return ast_up_to_date_; }
+
+private:
+    std::string source_;
+    std::shared_ptr<Interner> interner_ = std::make_shared<Interner>();
+    TokenBuffer tokens_;
+    std::unique_ptr<AbstractSyntaxTree> ast_;
+    /// @brief Span of every statement of the AST, see *Parser::set_statement_spans()*
+    std::vector<StatementSpan> spans_;
+    bool tokens_up_to_date_ = false;
+    bool ast_up_to_date_ = false;
+
+    SourceView get_source_view() const noexcept;
+    void relex_program();
+    void reparse_program();
+
+    /// @brief Re-lex after the text of [offset, offset + removed_length) was replaced
+    /// by *inserted_length* characters
+    /// @param first_token Set to the first damaged token
+    /// @param end_token Set to the end of the damaged range, before the edit
+    /// @param tokens Set to the tokens now in place of [first_token, end_token)
+    void relex(std::size_t offset, std::size_t removed_length, std::size_t inserted_length,
+               std::size_t &first_token, std::size_t &end_token, std::vector<BufferedToken> &tokens);
+    /// @brief Re-parse the smallest statement enclosing the old tokens [first_token, end_token),
+    /// now replaced by *token_count* tokens
+    /// @return Number of re-parsed tokens, or 0 if no statement could be re-parsed alone
+    std::size_t reparse(std::size_t first_token, std::size_t end_token, std::size_t token_count);
+    /// @brief Put *node* in place of the statement of *span* in the AST
+    void replace_node(const StatementSpan &span, AstNode *node) noexcept;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "interner.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+#include "source.hpp"
+
+/// @note Must be a power of two
+static constexpr std::size_t kInitialSlotCount = 64;
+
+Interner::Interner() : slots_(kInitialSlotCount, kInvalidSymbol) {}
+
+std::uint32_t Interner::hash(SourceView name) noexcept
+{
+    /// @note FNV-1a, identifiers are short
+    std::uint32_t result = 2166136261u;
+    for (std::size_t i = 0; i < name.length(); i++)
+    {
+        result ^= static_cast<unsigned char>(name[i]);
+        result *= 16777619u;
+    }
+    return result;
+}
+
+bool Interner::equals(const Entry &entry, SourceView name) const noexcept
+{
+    return entry.length == name.length() &&
+           std::memcmp(chars_.data() + entry.offset, name.data(), name.length()) == 0;
+}
+
+std::size_t Interner::find_slot(SourceView name, std::uint32_t name_hash) const noexcept
+{
+    std::size_t mask = slots_.size() - 1;
+    std::size_t slot = name_hash & mask;
+    while (slots_[slot] != kInvalidSymbol)
+    {
+        const Entry &entry = entries_[slots_[slot]];
+        if (entry.hash == name_hash && equals(entry, name))
+        {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+SymbolId Interner::find(SourceView name) const noexcept
+{
+    return slots_[find_slot(name, hash(name))];
+}
+
+SymbolId Interner::intern(SourceView name)
+{
+    std::uint32_t name_hash = hash(name);
+    std::size_t slot = find_slot(name, name_hash);
+    if (slots_[slot] != kInvalidSymbol)
+    {
+        return slots_[slot];
+    }
+
+    SymbolId symbol = static_cast<SymbolId>(entries_.size());
+    entries_.push_back({static_cast<std::uint32_t>(chars_.length()),
+                        static_cast<std::uint32_t>(name.length()),
+                        name_hash});
+    chars_.append(name.data(), name.length());
+    slots_[slot] = symbol;
+
+    /// @note Keep the load factor under 1/2 so probe sequences stay short
+    if (entries_.size() * 2 > slots_.size())
+    {
+        grow();
+    }
+
+    return symbol;
+}
+
+SourceView Interner::get_name(SymbolId symbol) const noexcept
+{
+    const Entry &entry = entries_[symbol];
+    return SourceView(chars_.data() + entry.offset, entry.length);
+}
+
+void Interner::grow()
+{
+    std::vector<SymbolId> slots(slots_.size() * 2, kInvalidSymbol);
+    std::size_t mask = slots.size() - 1;
+    for (SymbolId symbol = 0; symbol < entries_.size(); symbol++)
+    {
+        std::size_t slot = entries_[symbol].hash & mask;
+        while (slots[slot] != kInvalidSymbol)
+        {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = symbol;
+    }
+    slots_.swap(slots);
+}
+
+std::size_t Interner::get_footprint() const noexcept
+{
+    return chars_.capacity() + entries_.capacity() * sizeof(Entry) + slots_.capacity() * sizeof(SymbolId);
+}
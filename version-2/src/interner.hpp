@@ -0,0 +1,61 @@
+#ifndef INTERNER_HPP
+#define INTERNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "source.hpp"
+
+/// @brief Compact identifier of an interned name
+using SymbolId = std::uint32_t;
+
+/// @brief Marks a name that has not been interned (yet)
+constexpr SymbolId kInvalidSymbol = UINT32_MAX;
+
+/// @brief String interner, maps every distinct identifier to a dense 32-bit *SymbolId*.
+/// @note Symbols are numbered 0, 1, 2, ... in order of first appearance, so later passes
+/// can use them as indexes into plain arrays instead of hashing names again.
+/// Names are copied once into a single character pool.
+/// @warning This class is not thread-safe.
+class Interner
+{
+public:
+    Interner();
+
+    /// @brief Symbol of *name*, interning it on first sight
+    SymbolId intern(SourceView name);
+    /// @brief Symbol of *name*, or *kInvalidSymbol* if it was never interned
+    SymbolId find(SourceView name) const noexcept;
+
+    /// @brief Name of an interned symbol
+    /// @warning The returned view is invalidated by the next call to *intern()*
+    SourceView get_name(SymbolId symbol) const noexcept;
+
+    /// @brief Number of distinct interned names
+    std::size_t size() const noexcept { return entries_.size(); }
+    /// @brief Bytes used by the names, their entries and the hash table
+    std::size_t get_footprint() const noexcept;
+
+private:
+    struct Entry
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+        std::uint32_t hash;
+    };
+
+    /// @brief Every interned name, back to back
+    std::string chars_;
+    /// @brief Indexed by *SymbolId*
+    std::vector<Entry> entries_;
+    /// @brief Open addressing hash table storing *SymbolId*, *kInvalidSymbol* marks an empty slot
+    std::vector<SymbolId> slots_;
+
+    static std::uint32_t hash(SourceView name) noexcept;
+    bool equals(const Entry &entry, SourceView name) const noexcept;
+    std::size_t find_slot(SourceView name, std::uint32_t name_hash) const noexcept;
+    void grow();
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "interpreter.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include "token.hpp"
+
+/// @brief Wrapping INTEGER arithmetic, computed on unsigned integers to stay well-defined
+static int wrap(std::uint32_t value) noexcept { return static_cast<int>(value); }
+
+Interpreter::Interpreter(const SemanticAnalyzer &analyzer)
+    : ast_{analyzer.get_ast()}, variables_{analyzer.get_variables()}
+{
+    if (analyzer.has_errors())
+    {
+        __THROW_INTERPRETING_ERROR
+    }
+    values_.resize(variables_.size());
+}
+
+void Interpreter::run()
+{
+    for (std::size_t slot = 0; slot < values_.size(); slot++)
+    {
+        values_[slot] =
+            (variables_[slot].type == ValueType::REAL) ? Value::make_real(0.0) : Value::make_integer(0);
+    }
+    visit(ast_->get_root());
+}
+
+void Interpreter::visit_block(BlockNode *node)
+{
+    /// @note Declarations were handled by the analyzer
+    visit(node->get_compound_statement_node());
+}
+
+void Interpreter::visit_assignment_statement(AssignmentStatementNode *node)
+{
+    /// @note The analyzer promoted the value of an INTEGER expression stored in a REAL variable
+    Cell value = evaluate(node->get_rhs());
+    values_[node->get_lhs()->get_slot()] = (node->get_operation() == Operation::REAL_STORE)
+                                               ? Value::make_real(value.real)
+                                               : Value::make_integer(value.integer);
+}
+
+Interpreter::Cell Interpreter::evaluate(AstNode *node)
+{
+    operands_.clear();
+    walker_.walk(node, [this](AstNode *node) {
+        apply(node);
+        if (node->is_promoted())
+        {
+            Cell &value = operands_.back();
+            value.real = value.integer;
+        }
+    });
+    return operands_.back();
+}
+
+Interpreter::Cell Interpreter::pop() noexcept
+{
+    Cell value = operands_.back();
+    operands_.pop_back();
+    return value;
+}
+
+void Interpreter::apply(AstNode *node)
+{
+    Cell value;
+    switch (node->get_operation())
+    {
+    case Operation::INTEGER_CONSTANT:
+        value.integer = static_cast<IntNumNode *>(node)->get_token()->get_value();
+        operands_.push_back(value);
+        return;
+    case Operation::REAL_CONSTANT:
+        value.real = static_cast<RealNumNode *>(node)->get_token()->get_value();
+        operands_.push_back(value);
+        return;
+    case Operation::INTEGER_LOAD:
+        value.integer = values_[static_cast<VariableNode *>(node)->get_slot()].get_integer();
+        operands_.push_back(value);
+        return;
+    case Operation::REAL_LOAD:
+        value.real = values_[static_cast<VariableNode *>(node)->get_slot()].get_real();
+        operands_.push_back(value);
+        return;
+    case Operation::INTEGER_IDENTITY:
+    case Operation::REAL_IDENTITY:
+        return;
+    case Operation::INTEGER_NEGATE:
+        operands_.back().integer = wrap(0u - static_cast<std::uint32_t>(operands_.back().integer));
+        return;
+    case Operation::REAL_NEGATE:
+        operands_.back().real = -operands_.back().real;
+        return;
+    default:
+        break;
+    }
+
+    /// @note A binary operator, its rhs is on top of its lhs
+    Cell rhs = pop();
+    Cell &lhs = operands_.back();
+    switch (node->get_operation())
+    {
+    case Operation::INTEGER_ADD:
+        lhs.integer = wrap(static_cast<std::uint32_t>(lhs.integer) + static_cast<std::uint32_t>(rhs.integer));
+        break;
+    case Operation::INTEGER_SUBTRACT:
+        lhs.integer = wrap(static_cast<std::uint32_t>(lhs.integer) - static_cast<std::uint32_t>(rhs.integer));
+        break;
+    case Operation::INTEGER_MULTIPLY:
+        lhs.integer = wrap(static_cast<std::uint32_t>(lhs.integer) * static_cast<std::uint32_t>(rhs.integer));
+        break;
+    case Operation::INTEGER_DIVIDE:
+        if (rhs.integer == 0)
+        {
+            throw ExecutionError(Operation::INTEGER_DIVIDE, node->get_offset());
+        }
+        /// @note INT_MIN DIV -1 overflows, it wraps around like the other operators
+        lhs.integer =
+            (rhs.integer == -1) ? wrap(0u - static_cast<std::uint32_t>(lhs.integer)) : lhs.integer / rhs.integer;
+        break;
+    case Operation::REAL_ADD:
+        lhs.real += rhs.real;
+        break;
+    case Operation::REAL_SUBTRACT:
+        lhs.real -= rhs.real;
+        break;
+    case Operation::REAL_MULTIPLY:
+        lhs.real *= rhs.real;
+        break;
+    case Operation::REAL_DIVIDE:
+        lhs.real /= rhs.real;
+        break;
+    default:
+        __THROW_INTERPRETING_ERROR
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef INTERPRETER_HPP
+#define INTERPRETER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "ast.hpp"
+#include "ast_node.hpp"
+#include "ast_visitor.hpp"
+#include "interner.hpp"
+#include "semantic_analyzer.hpp"
+#include "value.hpp"
+
+#define __THROW_INTERPRETING_ERROR \
+    throw std::runtime_error("Error interpreting program");
+
+/// @brief Tree-walking interpreter of an analyzed program
+/// @note Variables live in a flat array indexed by the slots the *SemanticAnalyzer* resolved,
+/// no name is looked up while running. Expressions are evaluated by the typed *Operation*
+/// of their nodes, every value has a static type and is never checked at run time.
+/// Variables start at 0, INTEGER arithmetic wraps around on overflow.
+class Interpreter : public AstVisitor<Interpreter>
+{
+public:
+    /// @note Throws if the analysis found errors
+    explicit Interpreter(const SemanticAnalyzer &analyzer);
+
+    Interpreter(const Interpreter &) = delete;
+    Interpreter &operator=(const Interpreter &) = delete;
+
+    /// @brief Execute the program, from fresh variables
+    /// @note Throws an *ExecutionError* on a division by zero (DIV)
+    void run();
+
+    /// @brief Number of declared variables, slots are 0 .. count - 1 in declaration order
+    std::size_t get_variable_count() const noexcept { return values_.size(); }
+    SymbolId get_symbol(SlotIndex slot) const noexcept { return variables_[slot].name; }
+    /// @brief Value of the variable in *slot* (after *run()*, its final value)
+    const Value &get_value(SlotIndex slot) const noexcept { return values_[slot]; }
+    const std::shared_ptr<Interner> &get_interner() const noexcept { return ast_->get_interner(); }
+
+    // MARK: Handlers
+
+    void visit_block(BlockNode *node);
+    void visit_assignment_statement(AssignmentStatementNode *node);
+
+private:
+    AbstractSyntaxTree *ast_;
+    std::vector<VariableSymbol> variables_;
+    /// @brief Current value of every variable, indexed by slot
+    std::vector<Value> values_;
+    ExpressionWalker walker_;
+    /// @brief Value of an operand, its type is known from the operation using it
+    union Cell
+    {
+        int integer;
+        double real;
+    };
+    /// @brief Values of the operands evaluated by *evaluate()* and not used yet
+    std::vector<Cell> operands_;
+
+    /// @brief Value of an expression, REAL if it is promoted
+    /// @note Evaluated in post-order without recursion, expressions can nest 100k deep
+    Cell evaluate(AstNode *node);
+    /// @brief Replace the values of the operands of *node*, on top of *operands_*, by its value
+    void apply(AstNode *node);
+    Cell pop() noexcept;
+};
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef KEYWORD_HPP
+#define KEYWORD_HPP
+
+#include <cstddef>
+#include "token.hpp"
+
+/// @brief Reserved keyword spelling, upper-case
+struct ReservedKeyword
+{
+    const char *lexeme;
+    std::size_t length;
+    TokenType type;
+};
+
+constexpr ReservedKeyword kReservedKeywords[] = {
+    {"BEGIN", 5, TokenType::BEGIN},
+    {"END", 3, TokenType::END},
+    {"PROGRAM", 7, TokenType::PROGRAM},
+    {"VAR", 3, TokenType::VAR},
+    {"INTEGER", 7, TokenType::INTEGER},
+    {"REAL", 4, TokenType::REAL},
+    {"DIV", 3, TokenType::INTEGER_DIV}};
+
+constexpr std::size_t kReservedKeywordCount = sizeof(kReservedKeywords) / sizeof(kReservedKeywords[0]);
+constexpr std::size_t kKeywordMinLength = 3;
+constexpr std::size_t kKeywordMaxLength = 7;
+
+/// @brief Number of slots of the perfect hash table, must be a power of two
+constexpr std::size_t kKeywordSlotCount = 16;
+/// @brief Marks an empty slot of the perfect hash table
+constexpr unsigned char kNoKeyword = 0xFF;
+
+/// @brief Perfect hash of a keyword candidate.
+/// @note Only the first and the last characters are looked at. Masking with 0x1F maps
+/// 'a'..'z' and 'A'..'Z' to the same value, so the hash is case-insensitive.
+constexpr std::size_t hash_keyword(const char *lexeme, std::size_t length) noexcept
+{
+    return ((lexeme[0] & 0x1F) + (lexeme[length - 1] & 0x1F)) & (kKeywordSlotCount - 1);
+}
+
+struct KeywordTable
+{
+    /// @brief Index into kReservedKeywords, or kNoKeyword
+    unsigned char slots[kKeywordSlotCount];
+};
+
+/// @brief Build the perfect hash table at compile time.
+constexpr KeywordTable make_keyword_table()
+{
+    KeywordTable table{};
+    for (std::size_t slot = 0; slot < kKeywordSlotCount; slot++)
+    {
+        table.slots[slot] = kNoKeyword;
+    }
+    for (std::size_t i = 0; i < kReservedKeywordCount; i++)
+    {
+        table.slots[hash_keyword(kReservedKeywords[i].lexeme, kReservedKeywords[i].length)] =
+            static_cast<unsigned char>(i);
+    }
+    return table;
+}
+
+/// @brief Whether every keyword landed in its own slot
+constexpr bool is_keyword_hash_perfect()
+{
+    KeywordTable table = make_keyword_table();
+    std::size_t used_slots = 0;
+    for (std::size_t slot = 0; slot < kKeywordSlotCount; slot++)
+    {
+        used_slots += (table.slots[slot] != kNoKeyword) ? 1 : 0;
+    }
+    return used_slots == kReservedKeywordCount;
+}
+
+static_assert(is_keyword_hash_perfect(), "Keyword hash has collisions, adjust hash_keyword()");
+
+constexpr KeywordTable kKeywordTable = make_keyword_table();
+
+/// @brief Classify an identifier lexeme (letters and digits only), case-insensitively.
+/// @return The keyword token type, or *TokenType::ID* if *lexeme* is not a reserved keyword
+inline TokenType lookup_keyword(const char *lexeme, std::size_t length) noexcept
+{
+    if (length < kKeywordMinLength || length > kKeywordMaxLength)
+    {
+        return TokenType::ID;
+    }
+
+    unsigned char index = kKeywordTable.slots[hash_keyword(lexeme, length)];
+    if (index == kNoKeyword || kReservedKeywords[index].length != length)
+    {
+        return TokenType::ID;
+    }
+
+    const char *keyword = kReservedKeywords[index].lexeme;
+    for (std::size_t i = 0; i < length; i++)
+    {
+        /// @note Clearing bit 0x20 upper-cases a letter, and never turns a digit into a letter
+        if ((lexeme[i] & ~0x20) != keyword[i])
+        {
+            return TokenType::ID;
+        }
+    }
+
+    return kReservedKeywords[index].type;
+}
+
+#endif
@@ -1,97 +1,177 @@
 #include "lexer.hpp"
 #include <string>
-#include <unordered_map>
+#include "char_scan.hpp"
+#include "keyword.hpp"
+#include "numeric_literal.hpp"
 #include "token.hpp"
-
-static const std::unordered_map<std::string, Token> kReversedKeywordTokenMap = {
-    {"BEGIN", Token(TokenType::BEGIN)},
-    {"END", Token(TokenType::END)},
-    {"PROGRAM", Token(TokenType::PROGRAM)},
-    {"VAR", Token(TokenType::VAR)},
-    {"INTEGER", Token(TokenType::INTEGER)},
-    {"REAL", Token(TokenType::REAL)},
-    {"DIV", Token(TokenType::INTEGER_DIV)}};
+#include "token_buffer.hpp"
 
 /// @note This constructor make a copy of code
-Lexer::Lexer(const std::string &code) : code_{code}, current_char_{code_[pos_]} {}
+Lexer::Lexer(const std::string &code)
+    : owned_code_{code}, code_{owned_code_.data(), owned_code_.length()},
+      current_char_{code_.length() > 0 ? code_[0] : kNull} {}
 /// @note This constructor make a move of code instead of copy
-Lexer::Lexer(std::string &&code) : code_{std::move(code)}, current_char_{code_[pos_]} {}
+Lexer::Lexer(std::string &&code)
+    : owned_code_{std::move(code)}, code_{owned_code_.data(), owned_code_.length()},
+      current_char_{code_.length() > 0 ? code_[0] : kNull} {}
+/// @note This constructor neither copies nor owns code
+Lexer::Lexer(SourceView code, std::size_t base_offset)
+    : code_{code}, current_char_{code_.length() > 0 ? code_[0] : kNull}, base_offset_{base_offset} {}
+/// @note This constructor only reads the first chunk, the rest is read on demand
+Lexer::Lexer(std::unique_ptr<SourceStream> stream, std::size_t chunk_size)
+    : current_char_{kNull}, stream_{std::move(stream)}, chunk_size_{chunk_size}
+{
+    owned_code_.reserve(chunk_size_ * 2);
+    std::size_t keep_from = 0;
+    refill(keep_from);
+}
+
+const std::vector<Diagnostic> &Lexer::get_diagnostics() const noexcept { return diagnostics_; }
+
+void Lexer::set_interner(std::shared_ptr<Interner> interner) noexcept { interner_ = std::move(interner); }
+const std::shared_ptr<Interner> &Lexer::get_interner() const noexcept { return interner_; }
+
+void Lexer::set_error_mode(ErrorMode mode) noexcept { error_mode_ = mode; }
 
 void Lexer::advance() noexcept
 {
     pos_++;
-    current_char_ = (pos_ > code_.length() - 1) ? kNull : code_[pos_];
+    current_char_ = (pos_ >= code_.length()) ? kNull : code_[pos_];
+}
+
+void Lexer::seek(std::size_t pos) noexcept
+{
+    pos_ = pos;
+    current_char_ = (pos_ >= code_.length()) ? kNull : code_[pos_];
 }
 
 char Lexer::peek() const noexcept
 {
-    int peek_pos = pos_ + 1;
-    return (peek_pos > code_.length() - 1) ? kNull : code_[peek_pos];
+    std::size_t peek_pos = pos_ + 1;
+    return (peek_pos >= code_.length()) ? kNull : code_[peek_pos];
 }
 
-void Lexer::skip_whitespace() noexcept
+std::uint32_t Lexer::offset_of(std::size_t pos) const noexcept
 {
-    while (current_char_ != kNull && current_char_ == kWhitespace)
+    return static_cast<std::uint32_t>(base_offset_ + pos);
+}
+
+bool Lexer::refill(std::size_t &keep_from)
+{
+    if (stream_ == nullptr)
     {
-        advance();
+        return false;
     }
+
+    /// @note Consumed characters are dropped, the window never holds more than
+    /// the pending token plus one chunk
+    owned_code_.erase(0, keep_from);
+    base_offset_ += keep_from;
+    pos_ -= keep_from;
+    keep_from = 0;
+
+    std::size_t kept = owned_code_.length();
+    owned_code_.resize(kept + chunk_size_);
+    std::size_t count = stream_->read(&owned_code_[kept], chunk_size_);
+    owned_code_.resize(kept + count);
+
+    code_ = SourceView(owned_code_.data(), owned_code_.length());
+    seek(pos_);
+    return count > 0;
 }
 
-void Lexer::skip_comment() noexcept
+void Lexer::scan_run(std::size_t &start, std::size_t (*scan)(const char *, std::size_t, std::size_t))
 {
-    while (current_char_ != kRightCurlyBrace)
+    seek(scan(code_.data(), pos_, code_.length()));
+    while (pos_ >= code_.length() && refill(start))
     {
-        advance();
+        seek(scan(code_.data(), pos_, code_.length()));
     }
+}
 
-    /// @note ignore the closing curly brace, aka. '}'
-    advance();
+/// @note The scanning below jumps over whole runs of characters at once,
+/// see char_scan.hpp for the vectorized implementations.
+
+void Lexer::skip_whitespace() noexcept
+{
+    seek(scan_whitespace(code_.data(), pos_, code_.length()));
 }
 
-Token *Lexer::id() noexcept
+void Lexer::skip_comment()
 {
-    std::string result;
-    while (current_char_ != kNull && std::isalnum(current_char_))
+    /// @note An unterminated comment runs until the end of the code
+    seek(find_char(code_.data(), pos_, code_.length(), kRightCurlyBrace));
+    std::size_t keep_from = pos_;
+    while (pos_ >= code_.length() && refill(keep_from))
     {
-        result += current_char_;
-        advance();
+        /// @note The comment goes on in the next chunk, nothing needs to be kept
+        seek(find_char(code_.data(), pos_, code_.length(), kRightCurlyBrace));
+        keep_from = pos_;
     }
 
-    auto it = kReversedKeywordTokenMap.find(result);
-    return (it != kReversedKeywordTokenMap.end()) ? new Token(it->second) : new IdToken(result);
+    /// @note ignore the closing curly brace, aka. '}'
+    if (current_char_ != kNull)
+    {
+        advance();
+    }
 }
 
-Token *Lexer::number() noexcept
+BufferedToken Lexer::id()
 {
-    std::string result;
-    while (current_char_ != kNull && std::isdigit(current_char_))
+    std::size_t start = pos_;
+    scan_run(start, scan_alnum);
+
+    const char *lexeme = code_.data() + start;
+    std::size_t length = pos_ - start;
+    TokenType type = lookup_keyword(lexeme, length);
+    if (type != TokenType::ID)
     {
-        result += current_char_;
-        advance();
+        return BufferedToken(type, offset_of(start));
     }
 
+    if (interner_ == nullptr && stream_ != nullptr)
+    {
+        /// @note The lexeme is about to be discarded, it must be interned
+        interner_ = std::make_shared<Interner>();
+    }
+    SymbolId symbol = (interner_ != nullptr) ? interner_->intern(SourceView(lexeme, length)) : kInvalidSymbol;
+    return BufferedToken::make_id(offset_of(start), length, symbol);
+}
+
+BufferedToken Lexer::number()
+{
+    std::size_t start = pos_;
+    scan_run(start, scan_digits);
+
     if (current_char_ == kDot)
     {
-        result += current_char_;
         advance();
+        scan_run(start, scan_digits);
 
-        while (current_char_ != kNull && std::isdigit(current_char_))
+        RealLiteral real = parse_real_literal(code_.data() + start, pos_ - start);
+        if (real.status == LiteralStatus::OUT_OF_RANGE)
         {
-            result += current_char_;
-            advance();
+            diagnostics_.emplace_back(offset_of(start), "Real literal out of range");
         }
 
-        return new RealNumToken(std::stof(result));
+        return BufferedToken::make_real_num(offset_of(start), real.value);
     }
 
-    return new IntNumToken(std::stoi(result));
+    IntegerLiteral integer = parse_integer_literal(code_.data() + start, pos_ - start);
+    if (integer.status == LiteralStatus::OUT_OF_RANGE)
+    {
+        diagnostics_.emplace_back(offset_of(start), "Integer literal out of range");
+    }
+
+    return BufferedToken::make_int_num(offset_of(start), integer.value);
 }
 
-Token *Lexer::get_next_token()
+BufferedToken Lexer::scan()
 {
-    while (current_char_ != kNull)
+    std::size_t keep_from = pos_;
+    while (current_char_ != kNull || (pos_ >= code_.length() && refill(keep_from = pos_)))
     {
-        if (current_char_ == kWhitespace)
+        if (is_whitespace(current_char_))
         {
             skip_whitespace();
             continue;
@@ -115,73 +195,141 @@ Token *Lexer::get_next_token()
 
         if (current_char_ == kColon)
         {
+            std::size_t start = pos_;
+            if (pos_ + 1 >= code_.length())
+            {
+                refill(start);
+            }
+
             if (peek() == kEqualsSign)
             {
                 advance(); // ":"
                 advance(); // "="
-                return new Token(TokenType::ASSIGN);
+                return BufferedToken(TokenType::ASSIGN, offset_of(start));
             }
 
             advance();
-            return new Token(TokenType::COLON);
+            return BufferedToken(TokenType::COLON, offset_of(start));
         }
 
         if (current_char_ == kSemiColon)
         {
             advance();
-            return new Token(TokenType::SEMI_COLON);
+            return BufferedToken(TokenType::SEMI_COLON, offset_of(pos_ - 1));
         }
 
         if (current_char_ == kDot)
         {
             advance();
-            return new Token(TokenType::DOT);
+            return BufferedToken(TokenType::DOT, offset_of(pos_ - 1));
         }
 
         if (current_char_ == kPlus)
         {
             advance();
-            return new Token(TokenType::PLUS);
+            return BufferedToken(TokenType::PLUS, offset_of(pos_ - 1));
         }
 
         if (current_char_ == kMinus)
         {
             advance();
-            return new Token(TokenType::MINUS);
+            return BufferedToken(TokenType::MINUS, offset_of(pos_ - 1));
         }
 
         if (current_char_ == kMul)
         {
             advance();
-            return new Token(TokenType::MUL);
+            return BufferedToken(TokenType::MUL, offset_of(pos_ - 1));
         }
 
         if (current_char_ == kForwardSlash)
         {
             advance();
-            return new Token(TokenType::FLOAT_DIV);
+            return BufferedToken(TokenType::FLOAT_DIV, offset_of(pos_ - 1));
         }
 
         if (current_char_ == kLParen)
         {
             advance();
-            return new Token(TokenType::LPAREN);
+            return BufferedToken(TokenType::LPAREN, offset_of(pos_ - 1));
         }
 
         if (current_char_ == kRParen)
         {
             advance();
-            return new Token(TokenType::RPAREN);
+            return BufferedToken(TokenType::RPAREN, offset_of(pos_ - 1));
         }
 
         if (current_char_ == kComma)
         {
             advance();
-            return new Token(TokenType::COMMA);
+            return BufferedToken(TokenType::COMMA, offset_of(pos_ - 1));
+        }
+
+        if (error_mode_ == ErrorMode::THROW)
+        {
+            __THROW_TOKENIZING_ERROR
+        }
+
+        diagnostics_.emplace_back(offset_of(pos_), std::string("Unexpected character '") + current_char_ + "'",
+                                  DiagnosticSeverity::ERROR);
+        advance();
+    }
+
+    return BufferedToken(TokenType::END_OF_FILE, offset_of(pos_));
+}
+
+Token *Lexer::get_next_token()
+{
+    BufferedToken token = scan();
+    switch (token.get_type())
+    {
+    case TokenType::ID:
+        return new IdToken(token.get_symbol());
+    case TokenType::INTEGER_NUMBER:
+        return new IntNumToken(token.get_int_value());
+    case TokenType::REAL_NUMBER:
+        return new RealNumToken(token.get_real_value());
+    default:
+        return new Token(token.get_type());
+    }
+}
+
+std::size_t Lexer::scan_batch(BufferedToken *tokens, std::size_t capacity)
+{
+    std::size_t count = 0;
+    while (count < capacity)
+    {
+        tokens[count] = scan();
+        if (tokens[count++].get_type() == TokenType::END_OF_FILE)
+        {
+            break;
         }
+    }
+
+    return count;
+}
+
+TokenBuffer Lexer::tokenize()
+{
+    /// @note Lexemes of a streaming lexer do not outlive their chunk, and token offsets
+    /// of a slice do not index the slice itself
+    TokenBuffer buffer((stream_ != nullptr || base_offset_ != 0) ? SourceView() : code_, interner_);
+    /// @note Rough estimation, one token every few characters
+    buffer.reserve(code_.length() / 4 + 1);
 
-        __THROW_TOKENIZING_ERROR
+    BufferedToken token = scan();
+    while (token.get_type() != TokenType::END_OF_FILE)
+    {
+        buffer.push_back(token);
+        token = scan();
     }
+    buffer.push_back(token);
+
+    return buffer;
+}
 
-    return new Token(TokenType::END_OF_FILE);
+SourceView Lexer::get_lexeme(const BufferedToken &token) const noexcept
+{
+    return code_.slice(token.get_offset() - base_offset_, token.get_length());
 }
\ No newline at end of file
@@ -1,43 +1,122 @@
 #ifndef LEXER_HPP
 #define LEXER_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
+#include "diagnostic.hpp"
+#include "interner.hpp"
+#include "source.hpp"
 #include "token.hpp"
+#include "token_buffer.hpp"
 
 #define __THROW_TOKENIZING_ERROR \
     throw std::runtime_error("Error tokenizing input");
 
+/// @brief Default number of characters read at once from a *SourceStream*
+constexpr std::size_t kDefaultChunkSize = 64 * 1024;
+
 /// @brief Lexical analyzer (also known as scanner or tokenizer)
 class Lexer
 {
 public:
     explicit Lexer(const std::string &code);
     explicit Lexer(std::string &&code);
+    /// @brief Tokenize *code* in place, without copying it.
+    /// @warning The caller guarantees the viewed characters (e.g. a *MappedFile*)
+    /// outlive the lexer and every token buffer / lexeme produced by it.
+    /// @param base_offset Offset of *code* in the whole program when *code* is only a slice
+    /// of it (e.g. a chunk of a parallel tokenization), token offsets are shifted by it
+    explicit Lexer(SourceView code, std::size_t base_offset = 0);
+    /// @brief Tokenize code read from *stream* in chunks of *chunk_size* characters.
+    /// @note Memory stays bounded by about one chunk plus the longest token, tokens and
+    /// comments may straddle chunks. Identifiers are always interned in this mode, since
+    /// the characters of a chunk are discarded once consumed (*get_lexeme()* is unusable).
+    explicit Lexer(std::unique_ptr<SourceStream> stream, std::size_t chunk_size = kDefaultChunkSize);
+
+    /// @brief Problems found so far that did not stop tokenizing (e.g. out of range literals)
+    const std::vector<Diagnostic> &get_diagnostics() const noexcept;
+
+    /// @brief Share an interner between several lexers (a compilation session),
+    /// or pass nullptr to leave identifiers un-interned (slices only)
+    /// @note By default every lexer creates its own interner
+    void set_interner(std::shared_ptr<Interner> interner) noexcept;
+    const std::shared_ptr<Interner> &get_interner() const noexcept;
+
+    /// @brief With *ErrorMode::COLLECT*, an unexpected character is reported as an error
+    /// diagnostic and skipped instead of throwing
+    /// @note *ErrorMode::THROW* by default
+    void set_error_mode(ErrorMode mode) noexcept;
+
+    Lexer(const Lexer &) = delete;
+    Lexer &operator=(const Lexer &) = delete;
 
     /// @brief This method is responsible for breaking a sentence
     /// apart into tokens. One token at a time.
+    /// @note Every returned token is heap-allocated, prefer *scan()* or *tokenize()*.
     Token *get_next_token();
 
+    /// @brief Same as *get_next_token()* but returns a value token, no heap allocation.
+    BufferedToken scan();
+
+    /// @brief Scan up to *capacity* tokens into *tokens* in one call, stopping after END_OF_FILE
+    /// @return Number of tokens written, at least one if *capacity* is not 0
+    std::size_t scan_batch(BufferedToken *tokens, std::size_t capacity);
+
+    /// @brief Tokenize the whole program at once into a contiguous buffer.
+    /// The last token of the buffer is always *TokenType::END_OF_FILE*.
+    TokenBuffer tokenize();
+
+    /// @brief Slice of the source holding the lexeme of an identifier token produced by this lexer
+    /// @warning Not available for a streaming lexer, use the interned symbol of the token
+    SourceView get_lexeme(const BufferedToken &token) const noexcept;
+
 protected:
-    /// @brief Program code to be tokenized
-    std::string code_;
+    /// @brief Storage of the program code when the lexer was given a std::string,
+    /// or refill buffer of a streaming lexer,
+    /// empty when tokenizing a caller-owned *SourceView*
+    std::string owned_code_;
+    /// @brief Program code to be tokenized (the current window of a streaming lexer)
+    SourceView code_;
     /// @brief Current char
     char current_char_;
     /// @brief Position of current_char_ in code_
-    int pos_ = 0;
+    std::size_t pos_ = 0;
+    /// @brief Offset in the whole program of code_[0], 0 unless streaming or lexing a slice
+    std::size_t base_offset_ = 0;
+    /// @brief Source of a streaming lexer, nullptr otherwise
+    std::unique_ptr<SourceStream> stream_;
+    std::size_t chunk_size_ = kDefaultChunkSize;
+    /// @brief Interner of identifier tokens
+    std::shared_ptr<Interner> interner_ = std::make_shared<Interner>();
+    std::vector<Diagnostic> diagnostics_;
+    ErrorMode error_mode_ = ErrorMode::THROW;
 
     /// @brief Advance the 'pos' pointer and set the 'current_char' variable.
     void advance() noexcept;
+    /// @brief Move the 'pos' pointer to *pos* and set the 'current_char' variable.
+    void seek(std::size_t pos) noexcept;
     /// @brief Peeking into the 'code_' buffer without actually consuming the next character.
     char peek() const noexcept;
+    /// @brief Offset in the whole program of code_[pos]
+    std::uint32_t offset_of(std::size_t pos) const noexcept;
+    /// @brief Streaming only: drop the characters before *keep_from*, append the next chunk
+    /// of the stream to the window, and rebase *keep_from* and 'pos' accordingly.
+    /// @return false if there was nothing more to read
+    bool refill(std::size_t &keep_from);
+    /// @brief Extend the run starting at *start* up to the first character *scan* rejects,
+    /// refilling the window if the run reaches its end
+    void scan_run(std::size_t &start, std::size_t (*scan)(const char *, std::size_t, std::size_t));
     /// @brief ignore whitespace
     void skip_whitespace() noexcept;
     /// @brief ignore comment
-    void skip_comment() noexcept;
+    void skip_comment();
     /// @brief Handle identifiers and reserved keywords
-    Token* id() noexcept;
+    BufferedToken id();
     /// @brief Return a (multidigit) integer or float consumed from the input.
-    Token* number() noexcept;
+    BufferedToken number();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include "line_index.hpp"
+#include <algorithm>
+#include "char_scan.hpp"
+#include "token.hpp"
+
+LineIndex::LineIndex(SourceView source) : source_{source} {}
+
+void LineIndex::build()
+{
+    line_starts_.push_back(0);
+    for (std::size_t pos = find_char(source_.data(), 0, source_.length(), kNewLine); pos < source_.length();
+         pos = find_char(source_.data(), pos + 1, source_.length(), kNewLine))
+    {
+        line_starts_.push_back(static_cast<std::uint32_t>(pos + 1));
+    }
+}
+
+SourcePosition LineIndex::locate(std::uint32_t offset)
+{
+    if (line_starts_.empty())
+    {
+        build();
+    }
+
+    offset = std::min(offset, static_cast<std::uint32_t>(source_.length()));
+    /// @note The line is the last one starting at or before *offset*
+    auto next_line = std::upper_bound(line_starts_.begin(), line_starts_.end(), offset);
+    std::uint32_t line = static_cast<std::uint32_t>(next_line - line_starts_.begin());
+    return SourcePosition{line, offset - line_starts_[line - 1] + 1};
+}
+
+std::size_t LineIndex::get_line_count()
+{
+    if (line_starts_.empty())
+    {
+        build();
+    }
+    return line_starts_.size();
+}
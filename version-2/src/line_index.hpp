@@ -0,0 +1,39 @@
+#ifndef LINE_INDEX_HPP
+#define LINE_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "source.hpp"
+
+/// @brief Line and column of a character, both starting at 1
+/// @note Columns count bytes, a tab is one column
+struct SourcePosition
+{
+    std::uint32_t line;
+    std::uint32_t column;
+};
+
+/// @brief Translates source offsets into lines and columns
+/// @note The start of every line is only searched for on the first lookup, sources
+/// that never need a location (no diagnostics, no profiling) never pay for it.
+/// @warning The first lookup builds the index, concurrent first lookups are not safe.
+class LineIndex
+{
+public:
+    /// @note *source* is not copied, its characters must outlive the index
+    explicit LineIndex(SourceView source);
+
+    /// @brief Position of the character at *offset*, the end of the source for larger offsets
+    SourcePosition locate(std::uint32_t offset);
+    std::size_t get_line_count();
+
+private:
+    SourceView source_;
+    /// @brief Offset of the first character of every line, empty until the first lookup
+    std::vector<std::uint32_t> line_starts_;
+
+    void build();
+};
+
+#endif
@@ -0,0 +1,21 @@
+#include "lookahead_buffer.hpp"
+#include <cstddef>
+#include "lexer.hpp"
+#include "token.hpp"
+#include "token_buffer.hpp"
+
+LookaheadBuffer::LookaheadBuffer(Lexer *lexer) : lexer_{lexer} {}
+
+void LookaheadBuffer::fill()
+{
+    /// @note The free slots are at most two runs, up to the end of the ring and from its start
+    while (!end_reached_ && count_ < kLookaheadCapacity)
+    {
+        std::size_t tail = (head_ + count_) & kIndexMask;
+        std::size_t free_run = (tail >= head_) ? kLookaheadCapacity - tail : head_ - tail;
+        std::size_t scanned = lexer_->scan_batch(&tokens_[tail], free_run);
+
+        count_ += scanned;
+        end_reached_ = tokens_[(tail + scanned - 1) & kIndexMask].get_type() == TokenType::END_OF_FILE;
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef LOOKAHEAD_BUFFER_HPP
+#define LOOKAHEAD_BUFFER_HPP
+
+#include <cstddef>
+#include "lexer.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Number of tokens a *LookaheadBuffer* holds, bounds how far the parser can peek
+constexpr std::size_t kLookaheadCapacity = 64;
+
+static_assert((kLookaheadCapacity & (kLookaheadCapacity - 1)) == 0, "kLookaheadCapacity must be a power of two");
+
+/// @brief Fixed-capacity ring of upcoming tokens between a *Lexer* and its consumer
+/// @note Tokens are scanned in batches filling every free slot at once (see *Lexer::scan_batch()*),
+/// instead of one lexer call per consumed token. Once END_OF_FILE is buffered the lexer
+/// is not called anymore, and peeking or advancing past the end keeps returning END_OF_FILE.
+class LookaheadBuffer
+{
+public:
+    /// @note *lexer* is not owned and must outlive this object
+    explicit LookaheadBuffer(Lexer *lexer);
+
+    LookaheadBuffer(const LookaheadBuffer &) = delete;
+    LookaheadBuffer &operator=(const LookaheadBuffer &) = delete;
+
+    /// @brief Token *k* positions ahead of the current one, the current one for 0
+    /// @warning *k* must be lower than *kLookaheadCapacity*
+    /// @note The reference stays valid until the next call to *peek()* or *advance()*
+    const BufferedToken &peek(std::size_t k)
+    {
+        if (k >= count_)
+        {
+            fill();
+            /// @note Only END_OF_FILE lies past the buffered tokens now
+            k = (k < count_) ? k : count_ - 1;
+        }
+        return tokens_[(head_ + k) & kIndexMask];
+    }
+
+    /// @brief Consume the current token
+    void advance()
+    {
+        if (count_ == 0)
+        {
+            fill();
+        }
+        if (count_ == 1 && end_reached_)
+        {
+            return;
+        }
+        head_ = (head_ + 1) & kIndexMask;
+        count_--;
+    }
+
+private:
+    static constexpr std::size_t kIndexMask = kLookaheadCapacity - 1;
+
+    Lexer *lexer_;
+    BufferedToken tokens_[kLookaheadCapacity];
+    /// @brief Slot of the current token
+    std::size_t head_ = 0;
+    /// @brief Number of buffered tokens, starting at head_
+    std::size_t count_ = 0;
+    /// @brief END_OF_FILE is the last buffered token
+    bool end_reached_ = false;
+
+    /// @brief Scan tokens into every free slot, up to END_OF_FILE
+    void fill();
+};
+
+#endif
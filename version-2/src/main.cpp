@@ -1,13 +1,24 @@
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <vector>
+#include "ast_file.hpp"
+#include "diagnostic.hpp"
+#include "flat_ast.hpp"
 #include "lexer.hpp"
+#include "line_index.hpp"
 #include "parser.hpp"
+#include "register_vm.hpp"
+#include "semantic_analyzer.hpp"
+#include "source.hpp"
 #include "token.hpp"
+#include "token_buffer.hpp"
 
-int main()
-{
-    Lexer *lexer = new Lexer("PROGRAM Part10AST; \
+static const char *kSampleProgram = "PROGRAM Part10AST; \
 VAR \
    a, b : INTEGER; \
    y    : REAL; \
@@ -16,11 +27,157 @@ BEGIN {Part10AST} \
    a := 2; \
    b := 10 * a + 10 * a DIV 4; \
    y := 20 / 7 + 3.14; \
-END.  {Part10AST}");
+END.  {Part10AST}";
+
+/// @brief Print *diagnostics* on the standard error, located by *lines*
+/// (or by their offset if the source is gone)
+/// @return true if one of them is an error
+static bool report(const std::vector<Diagnostic> &diagnostics, LineIndex *lines)
+{
+    bool has_errors = false;
+    for (const Diagnostic &diagnostic : diagnostics)
+    {
+        std::cerr << map_diagnostic_severity_to_string(diagnostic.get_severity());
+        if (lines != nullptr)
+        {
+            SourcePosition position = lines->locate(diagnostic.get_offset());
+            std::cerr << " at " << position.line << ':' << position.column;
+        }
+        else
+        {
+            std::cerr << " at offset " << diagnostic.get_offset();
+        }
+        std::cerr << ": " << diagnostic.get_message() << '\n';
+        has_errors = has_errors || diagnostic.get_severity() == DiagnosticSeverity::ERROR;
+    }
+    return has_errors;
+}
+
+/// @brief Analyze and compile the program of *ast*, then run it and print the final value
+/// of every variable, or print its register code if *disassembling*
+/// @return false if it could not be run
+static bool execute(AbstractSyntaxTree *ast, LineIndex *lines, bool disassembling)
+{
+    SemanticAnalyzer analyzer(ast);
+    if (!analyzer.analyze())
+    {
+        report(analyzer.get_diagnostics(), lines);
+        return false;
+    }
+
+    try
+    {
+        RegisterProgram program = RegisterCompiler(analyzer).compile();
+        if (disassembling)
+        {
+            disassemble(program, std::cout);
+            return true;
+        }
+
+        RegisterVm vm(&program);
+        vm.run();
+        for (SlotIndex slot = 0; slot < vm.get_variable_count(); ++slot)
+        {
+            std::cout << vm.get_interner()->get_name(vm.get_symbol(slot)).to_string() << " = " << vm.get_value(slot)
+                      << '\n';
+        }
+    }
+    catch (const ExecutionError &error)
+    {
+        report({Diagnostic(error.get_offset(), error.what(), DiagnosticSeverity::ERROR)}, lines);
+        return false;
+    }
+    catch (const std::runtime_error &error)
+    {
+        std::cerr << map_diagnostic_severity_to_string(DiagnosticSeverity::ERROR) << ": " << error.what() << '\n';
+        return false;
+    }
+    return true;
+}
+
+/// @brief Whether the file at *cache_path* exists and was modified after the one at *source_path*
+static bool is_up_to_date(const char *cache_path, const char *source_path)
+{
+    struct stat cache_stat, source_stat;
+    if (stat(cache_path, &cache_stat) != 0 || stat(source_path, &source_stat) != 0)
+    {
+        return false;
+    }
+    return cache_stat.st_mtime >= source_stat.st_mtime;
+}
 
-    Parser *parser = new Parser(lexer);
+int main(int argc, char *argv[])
+{
+    /// @note "--disassemble" before the other arguments prints the register code instead of running it
+    bool disassembling = argc > 1 && std::strcmp(argv[1], "--disassemble") == 0;
+    if (disassembling)
+    {
+        argv++;
+        argc--;
+    }
+
+    /// @note "-" streams the program from the standard input, the parser pulls
+    /// tokens while the input is still being read
+    if (argc > 1 && std::strcmp(argv[1], "-") == 0)
+    {
+        Lexer *lexer = new Lexer(std::unique_ptr<SourceStream>(new FileDescriptorSource(STDIN_FILENO)));
+        lexer->set_error_mode(ErrorMode::COLLECT);
+        Parser *parser = new Parser(lexer);
+        parser->set_error_mode(ErrorMode::COLLECT);
+
+        AbstractSyntaxTree *ast = parser->parse();
+        /// @note Both | are evaluated, every diagnostic is printed. The streamed
+        /// source is not kept, diagnostics are located by offset.
+        bool has_errors = report(lexer->get_diagnostics(), nullptr) | report(parser->get_diagnostics(), nullptr);
+        has_errors = has_errors || !execute(ast, nullptr, disassembling);
+
+        return has_errors ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    /// @note With an AST file after the program, a tree saved by a previous run is
+    /// memory mapped instead of parsing the program again, unless the program changed since
+    /// (or the file is damaged, it is then parsed and saved again)
+    if (argc > 2 && is_up_to_date(argv[2], argv[1]))
+    {
+        std::unique_ptr<AbstractSyntaxTree> ast;
+        try
+        {
+            std::unique_ptr<FlatAst> flat_ast(AstFile::load(argv[2]));
+            ast.reset(flat_ast->to_tree());
+        }
+        catch (const std::runtime_error &)
+        {
+        }
+
+        if (ast != nullptr)
+        {
+            /// @note The program is only read to locate diagnostics, on the first one
+            MappedFile source_file(argv[1]);
+            LineIndex lines(source_file.get_view());
+            return execute(ast.get(), &lines, disassembling) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    /// @note A program file passed on the command line is memory mapped
+    /// and tokenized in place, it is never copied
+    MappedFile *source_file = (argc > 1) ? new MappedFile(argv[1]) : nullptr;
+    Lexer *lexer = (source_file != nullptr) ? new Lexer(source_file->get_view()) : new Lexer(kSampleProgram);
+    lexer->set_error_mode(ErrorMode::COLLECT);
+
+    TokenBuffer tokens = lexer->tokenize();
+    Parser *parser = new Parser(&tokens);
+    parser->set_error_mode(ErrorMode::COLLECT);
 
     AbstractSyntaxTree *ast = parser->parse();
+    LineIndex lines = (source_file != nullptr) ? LineIndex(source_file->get_view())
+                                               : LineIndex(SourceView(kSampleProgram, std::strlen(kSampleProgram)));
+    bool has_errors = report(lexer->get_diagnostics(), &lines) | report(parser->get_diagnostics(), &lines);
+
+    if (argc > 2 && !has_errors)
+    {
+        AstFile::save(FlatAst(ast), argv[2]);
+    }
+    has_errors = has_errors || !execute(ast, &lines, disassembling);
 
     // Token *token = lexer->get_next_token();
     // while (token->get_type() != TokenType::END_OF_FILE)
@@ -48,5 +205,5 @@ END.  {Part10AST}");
     // delete token;
     // delete lexer;
 
-    return EXIT_SUCCESS;
+    return has_errors ? EXIT_FAILURE : EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "parallel_lexer.hpp"
+#include <algorithm>
+#include <future>
+#include "char_scan.hpp"
+#include "lexer.hpp"
+#include "token.hpp"
+
+constexpr std::size_t ParallelLexer::kMinChunkSize;
+
+ParallelLexer::ParallelLexer(SourceView code, ThreadPool *pool) : code_{code}, pool_{pool} {}
+
+void ParallelLexer::set_interner(std::shared_ptr<Interner> interner) noexcept { interner_ = std::move(interner); }
+const std::shared_ptr<Interner> &ParallelLexer::get_interner() const noexcept { return interner_; }
+
+void ParallelLexer::set_error_mode(ErrorMode mode) noexcept { error_mode_ = mode; }
+
+const std::vector<Diagnostic> &ParallelLexer::get_diagnostics() const noexcept { return diagnostics_; }
+
+std::vector<ParallelLexer::Chunk> ParallelLexer::split() const
+{
+    /// @note A few chunks per thread even out chunks that are slower to tokenize
+    std::size_t chunk_count = pool_->get_thread_count() * 4;
+    std::size_t chunk_size = std::max(kMinChunkSize, code_.length() / chunk_count + 1);
+
+    std::vector<Chunk> chunks;
+    std::size_t begin = 0;
+    while (begin < code_.length())
+    {
+        std::size_t end = std::min(begin + chunk_size, code_.length());
+        while (end < code_.length() && !is_whitespace(code_[end]))
+        {
+            ++end;
+        }
+
+        Chunk chunk;
+        chunk.begin = begin;
+        chunk.end = end;
+        chunks.push_back(std::move(chunk));
+        begin = end;
+    }
+
+    return chunks;
+}
+
+void ParallelLexer::summarize(Chunk &chunk) const noexcept
+{
+    const char *data = code_.data();
+
+    std::size_t close = find_char(data, chunk.begin, chunk.end, kRightCurlyBrace);
+    chunk.resume = (close < chunk.end) ? close + 1 : chunk.end;
+
+    /// @note Starting inside a comment is the same as starting outside of it right after
+    /// its first '}', unless the whole chunk is part of the comment
+    CommentState *exit_state = chunk.exit_state;
+    std::size_t starts[2] = {chunk.begin, chunk.resume};
+    for (int state = OUTSIDE_COMMENT; state <= INSIDE_COMMENT; ++state)
+    {
+        if (state == INSIDE_COMMENT && close >= chunk.end)
+        {
+            exit_state[state] = INSIDE_COMMENT;
+            continue;
+        }
+
+        std::size_t pos = starts[state];
+        exit_state[state] = OUTSIDE_COMMENT;
+        while (pos < chunk.end)
+        {
+            pos = find_char(data, pos, chunk.end, kLeftCurlyBrace);
+            if (pos >= chunk.end)
+            {
+                break;
+            }
+
+            pos = find_char(data, pos + 1, chunk.end, kRightCurlyBrace);
+            if (pos >= chunk.end)
+            {
+                exit_state[state] = INSIDE_COMMENT;
+                break;
+            }
+            ++pos;
+        }
+    }
+}
+
+void ParallelLexer::lex(Chunk &chunk) const
+{
+    std::size_t begin = (chunk.entry_state == INSIDE_COMMENT) ? chunk.resume : chunk.begin;
+    Lexer lexer(code_.slice(begin, chunk.end - begin), begin);
+    /// @note Interners are not thread-safe, every chunk has its own one
+    chunk.interner = (interner_ != nullptr) ? std::make_shared<Interner>() : nullptr;
+    lexer.set_interner(chunk.interner);
+    lexer.set_error_mode(error_mode_);
+    /// @note Same rough estimation as *Lexer::tokenize()*
+    chunk.tokens.reserve((chunk.end - begin) / 4 + 1);
+
+    BufferedToken token = lexer.scan();
+    while (token.get_type() != TokenType::END_OF_FILE)
+    {
+        chunk.tokens.push_back(token);
+        token = lexer.scan();
+    }
+    chunk.diagnostics = lexer.get_diagnostics();
+}
+
+void ParallelLexer::stitch(Chunk &chunk, TokenBuffer &buffer) const noexcept
+{
+    std::size_t index = chunk.first_token;
+    for (BufferedToken token : chunk.tokens)
+    {
+        if (token.get_type() == TokenType::ID && chunk.interner != nullptr)
+        {
+            token = BufferedToken::make_id(token.get_offset(), token.get_length(), chunk.symbols[token.get_symbol()]);
+        }
+        buffer[index++] = token;
+    }
+
+    /// @note Release the chunk tokens right away, halving the peak memory
+    std::vector<BufferedToken>().swap(chunk.tokens);
+}
+
+template <typename Body>
+void ParallelLexer::for_each_chunk(std::vector<Chunk> &chunks, Body body)
+{
+    std::vector<std::future<void>> done;
+    done.reserve(chunks.size());
+    for (Chunk &chunk : chunks)
+    {
+        done.push_back(pool_->submit([&chunk, &body]() { body(chunk); }));
+    }
+
+    /// @note Every task must be over before an error unwinds *chunks*
+    for (std::future<void> &future : done)
+    {
+        future.wait();
+    }
+    for (std::future<void> &future : done)
+    {
+        future.get();
+    }
+}
+
+TokenBuffer ParallelLexer::tokenize()
+{
+    std::vector<Chunk> chunks = split();
+
+    for_each_chunk(chunks, [this](Chunk &chunk) { summarize(chunk); });
+
+    CommentState state = OUTSIDE_COMMENT;
+    for (Chunk &chunk : chunks)
+    {
+        chunk.entry_state = state;
+        state = chunk.exit_state[state];
+    }
+
+    for_each_chunk(chunks, [this](Chunk &chunk) { lex(chunk); });
+
+    /// @note Only the distinct names of every chunk are interned sequentially, interning
+    /// them in their local order of first appearance numbers them exactly like a sequential
+    /// lexer would
+    std::size_t token_count = 0;
+    diagnostics_.clear();
+    for (Chunk &chunk : chunks)
+    {
+        chunk.first_token = token_count;
+        token_count += chunk.tokens.size();
+
+        for (SymbolId local = 0; chunk.interner != nullptr && local < chunk.interner->size(); ++local)
+        {
+            chunk.symbols.push_back(interner_->intern(chunk.interner->get_name(local)));
+        }
+
+        diagnostics_.insert(diagnostics_.end(), chunk.diagnostics.begin(), chunk.diagnostics.end());
+    }
+
+    TokenBuffer buffer(code_, interner_);
+    buffer.resize(token_count + 1);
+    for_each_chunk(chunks, [this, &buffer](Chunk &chunk) { stitch(chunk, buffer); });
+    buffer[token_count] = BufferedToken(TokenType::END_OF_FILE, static_cast<std::uint32_t>(code_.length()));
+
+    return buffer;
+}
@@ -0,0 +1,91 @@
+#ifndef PARALLEL_LEXER_HPP
+#define PARALLEL_LEXER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "diagnostic.hpp"
+#include "interner.hpp"
+#include "source.hpp"
+#include "thread_pool.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Tokenizes a large program on several threads.
+/// @note The source is split into chunks at whitespace, which always separates tokens
+/// outside of comments. Being inside a `{}` comment is the only state a chunk cannot
+/// know from its own characters, so every chunk first computes where it would end up
+/// starting both outside and inside a comment (a cheap scan for braces). The real
+/// starting states are then chained from the first chunk, and chunks are tokenized
+/// independently with their own interner. Token buffers are finally stitched in order,
+/// also in parallel, remapping symbols so they match those of a sequential *Lexer::tokenize()*.
+class ParallelLexer
+{
+public:
+    /// @brief Smallest chunk worth handing to a thread
+    static constexpr std::size_t kMinChunkSize = 64 * 1024;
+
+    /// @note Neither *code* nor *pool* are owned, both must outlive the lexer
+    ParallelLexer(SourceView code, ThreadPool *pool);
+
+    /// @brief Interner of the stitched token buffer, same semantics as *Lexer::set_interner()*
+    void set_interner(std::shared_ptr<Interner> interner) noexcept;
+    const std::shared_ptr<Interner> &get_interner() const noexcept;
+
+    /// @brief Error mode of every chunk, same semantics as *Lexer::set_error_mode()*
+    void set_error_mode(ErrorMode mode) noexcept;
+
+    /// @brief Diagnostics of every chunk, in source order
+    const std::vector<Diagnostic> &get_diagnostics() const noexcept;
+
+    /// @brief Same result as *Lexer::tokenize()* on the whole code
+    /// @note Rethrows the tokenizing error of the first failing chunk, if any
+    TokenBuffer tokenize();
+
+private:
+    /// @brief Comment nesting state at a chunk boundary
+    enum CommentState : unsigned char
+    {
+        OUTSIDE_COMMENT,
+        INSIDE_COMMENT
+    };
+
+    struct Chunk
+    {
+        std::size_t begin;
+        std::size_t end;
+        /// @brief First position after the first '}' of the chunk, where tokenizing
+        /// resumes when the chunk starts inside a comment (*end* if there is none)
+        std::size_t resume;
+        /// @brief State at *end*, indexed by the state at *begin*
+        CommentState exit_state[2];
+        CommentState entry_state;
+
+        std::vector<BufferedToken> tokens;
+        std::shared_ptr<Interner> interner;
+        std::vector<Diagnostic> diagnostics;
+
+        /// @brief Index of the first token of the chunk in the stitched buffer
+        std::size_t first_token;
+        /// @brief Global symbol of every local symbol of *interner*
+        std::vector<SymbolId> symbols;
+    };
+
+    SourceView code_;
+    ThreadPool *pool_;
+    std::shared_ptr<Interner> interner_ = std::make_shared<Interner>();
+    std::vector<Diagnostic> diagnostics_;
+    ErrorMode error_mode_ = ErrorMode::THROW;
+
+    std::vector<Chunk> split() const;
+    /// @brief Speculative pass, fill *resume* and both *exit_state*
+    void summarize(Chunk &chunk) const noexcept;
+    /// @brief Tokenize the chunk from its *entry_state*
+    void lex(Chunk &chunk) const;
+    /// @brief Copy the tokens of the chunk to their final place, translating symbols
+    void stitch(Chunk &chunk, TokenBuffer &buffer) const noexcept;
+    /// @brief Run *body* on every chunk on the pool, then wait for all of them
+    template <typename Body>
+    void for_each_chunk(std::vector<Chunk> &chunks, Body body);
+};
+
+#endif
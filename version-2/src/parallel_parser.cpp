@@ -0,0 +1,181 @@
+#include "parallel_parser.hpp"
+#include <algorithm>
+#include <future>
+#include "parser.hpp"
+#include "token.hpp"
+
+constexpr std::size_t ParallelParser::kMinRangeTokenCount;
+
+ParallelParser::ParallelParser(const TokenBuffer *tokens, ThreadPool *pool) : tokens_{tokens}, pool_{pool} {}
+
+void ParallelParser::set_error_mode(ErrorMode mode) noexcept { error_mode_ = mode; }
+const std::vector<Diagnostic> &ParallelParser::get_diagnostics() const noexcept { return diagnostics_; }
+
+bool ParallelParser::match_statements()
+{
+    statement_starts_.clear();
+    statement_ends_.clear();
+
+    /// @note Declarations hold no BEGIN, the first one opens the program block
+    std::size_t index = 0;
+    while (index < tokens_->size() && (*tokens_)[index].get_type() != TokenType::BEGIN)
+    {
+        ++index;
+    }
+
+    std::size_t depth = 0;
+    for (; index < tokens_->size(); ++index)
+    {
+        switch ((*tokens_)[index].get_type())
+        {
+        case TokenType::BEGIN:
+            if (++depth == 1)
+            {
+                statement_starts_.push_back(index + 1);
+            }
+            break;
+        case TokenType::SEMI_COLON:
+            if (depth == 1)
+            {
+                statement_ends_.push_back(index);
+                statement_starts_.push_back(index + 1);
+            }
+            break;
+        case TokenType::END:
+            if (--depth == 0)
+            {
+                statement_ends_.push_back(index);
+                end_token_ = index;
+                return true;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    return false;
+}
+
+std::vector<ParallelParser::Range> ParallelParser::split() const
+{
+    /// @note A few ranges per thread even out statements that are slower to parse
+    std::size_t range_count = pool_->get_thread_count() * 4;
+    std::size_t token_count = end_token_ - statement_starts_.front();
+    std::size_t range_token_count = std::max(kMinRangeTokenCount, token_count / range_count + 1);
+
+    std::vector<Range> ranges;
+    std::size_t first = 0;
+    while (first < statement_starts_.size())
+    {
+        std::size_t end = first + 1;
+        while (end < statement_starts_.size() &&
+               statement_ends_[end - 1] - statement_starts_[first] < range_token_count)
+        {
+            ++end;
+        }
+
+        Range range;
+        range.first_statement = first;
+        range.end_statement = end;
+        range.has_errors = false;
+        ranges.push_back(std::move(range));
+        first = end;
+    }
+
+    return ranges;
+}
+
+void ParallelParser::parse_range(Range &range) const
+{
+    range.arena.reset(new Arena());
+    range.statements.reserve(range.end_statement - range.first_statement);
+
+    Parser parser(tokens_);
+    parser.set_error_mode(error_mode_);
+    for (std::size_t statement = range.first_statement; statement < range.end_statement; ++statement)
+    {
+        range.statements.push_back(parser.parse_statement(statement_starts_[statement], range.arena.get()));
+        /// @note A statement followed by anything but its separator is an error, as it is
+        /// for the sequential statement list
+        bool ends_at_separator = parser.get_token_index() == statement_ends_[statement];
+        if (!ends_at_separator && error_mode_ == ErrorMode::THROW)
+        {
+            __THROW_PARSING_ERROR
+        }
+        if (!ends_at_separator || !parser.get_diagnostics().empty())
+        {
+            range.has_errors = true;
+            return;
+        }
+    }
+}
+
+AbstractSyntaxTree *ParallelParser::parse()
+{
+    if (tokens_->get_interner() == nullptr || !match_statements())
+    {
+        return parse_sequentially();
+    }
+
+    diagnostics_.clear();
+    std::vector<Range> ranges = split();
+
+    std::vector<std::future<void>> done;
+    done.reserve(ranges.size());
+    for (Range &range : ranges)
+    {
+        done.push_back(pool_->submit([this, &range]() { parse_range(range); }));
+    }
+
+    /// @note Every task must be over before an error unwinds *ranges*
+    for (std::future<void> &future : done)
+    {
+        future.wait();
+    }
+    for (std::future<void> &future : done)
+    {
+        future.get();
+    }
+
+    for (Range &range : ranges)
+    {
+        if (range.has_errors)
+        {
+            return parse_sequentially();
+        }
+    }
+
+    std::vector<AstNode *> statements;
+    statements.reserve(statement_starts_.size());
+    for (Range &range : ranges)
+    {
+        statements.insert(statements.end(), range.statements.begin(), range.statements.end());
+    }
+
+    Parser parser(tokens_);
+    parser.set_error_mode(error_mode_);
+    parser.set_main_statements(&statements, end_token_);
+    std::unique_ptr<AbstractSyntaxTree> ast(parser.parse());
+    if (!parser.get_diagnostics().empty())
+    {
+        /// @note Recovering from an error in the header may not lead to the program block
+        /// found by the pre-pass
+        return parse_sequentially();
+    }
+    for (Range &range : ranges)
+    {
+        ast->adopt_arena(std::move(range.arena));
+    }
+
+    return ast.release();
+}
+
+AbstractSyntaxTree *ParallelParser::parse_sequentially()
+{
+    Parser parser(tokens_);
+    parser.set_error_mode(error_mode_);
+    AbstractSyntaxTree *ast = parser.parse();
+    diagnostics_ = parser.get_diagnostics();
+    return ast;
+}
@@ -0,0 +1,77 @@
+#ifndef PARALLEL_PARSER_HPP
+#define PARALLEL_PARSER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "arena.hpp"
+#include "ast.hpp"
+#include "ast_node.hpp"
+#include "diagnostic.hpp"
+#include "thread_pool.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Parses the statements of the program block on several threads.
+/// @note A linear pre-pass over the tokens matches BEGIN/END pairs and finds the `;`
+/// separating the top-level statements of the program block. Consecutive statements
+/// are grouped into ranges, every range is parsed by its own *Parser* into its own
+/// arena, and the statements are spliced in order into one *CompoundStatementNode*.
+/// The program header, declarations and closing END are parsed sequentially.
+class ParallelParser
+{
+public:
+    /// @brief Smallest number of tokens worth handing to a thread
+    static constexpr std::size_t kMinRangeTokenCount = 16 * 1024;
+
+    /// @note Neither *tokens* nor *pool* are owned, both must outlive the parser
+    ParallelParser(const TokenBuffer *tokens, ThreadPool *pool);
+
+    /// @brief Same semantics as *Parser::set_error_mode()*
+    /// @note With *ErrorMode::COLLECT* a program with errors is parsed again sequentially,
+    /// so that its diagnostics and recovery are exactly those of *Parser*
+    void set_error_mode(ErrorMode mode) noexcept;
+    const std::vector<Diagnostic> &get_diagnostics() const noexcept;
+
+    /// @brief Same tree as *Parser::parse()* on the same tokens
+    /// @note Falls back to a sequential parse when the pre-pass finds no well-formed
+    /// program block, or when identifiers were not interned by the lexer (interning
+    /// is not thread-safe). Rethrows the parsing error of the first failing range.
+    AbstractSyntaxTree *parse();
+
+private:
+    /// @brief Consecutive top-level statements
+    struct Range
+    {
+        /// @brief Index of the first statement in *statement_starts_*
+        std::size_t first_statement;
+        std::size_t end_statement;
+
+        /// @brief Owns the nodes of the statements, adopted by the tree
+        std::unique_ptr<Arena> arena;
+        std::vector<AstNode *> statements;
+        /// @brief A statement of the range has an error (*ErrorMode::COLLECT* only)
+        bool has_errors;
+    };
+
+    const TokenBuffer *tokens_;
+    ThreadPool *pool_;
+    ErrorMode error_mode_ = ErrorMode::THROW;
+    std::vector<Diagnostic> diagnostics_;
+    /// @brief Index of the first token of every top-level statement
+    std::vector<std::size_t> statement_starts_;
+    /// @brief Index of the `;` (or END) ending every top-level statement
+    std::vector<std::size_t> statement_ends_;
+    /// @brief Index of the END closing the program block
+    std::size_t end_token_ = 0;
+
+    /// @brief Find the top-level statements
+    /// @return false if the program block is not well-formed
+    bool match_statements();
+    std::vector<Range> split() const;
+    /// @brief Parse the statements of *range* into its arena
+    void parse_range(Range &range) const;
+    /// @brief Parse the whole program with a single *Parser*
+    AbstractSyntaxTree *parse_sequentially();
+};
+
+#endif
@@ -1,64 +1,159 @@
 #include "parser.hpp"
 #include "ast.hpp"
 #include "ast_node.hpp"
+#include "diagnostic.hpp"
 #include "token.hpp"
+#include "token_buffer.hpp"
+
+/// @brief Binding power of every token used as a binary operator, 0 for other tokens
+/// @note Indexed by *TokenType*, in declaration order
+static constexpr unsigned char kBinaryPrecedence[] = {
+    0, 0, 0, 0, 0, 0, // BEGIN END PROGRAM VAR INTEGER REAL
+    0, 1, 1, 2, 2, 2, // ASSIGN PLUS MINUS MUL FLOAT_DIV INTEGER_DIV
+    0, 0, 0, 0, 0, 0, // DOT COLON SEMI_COLON COMMA LPAREN RPAREN
+    0, 0, 0, 0,       // ID INTEGER_NUMBER REAL_NUMBER END_OF_FILE
+};
+static_assert(sizeof(kBinaryPrecedence) == static_cast<std::size_t>(TokenType::END_OF_FILE) + 1,
+              "kBinaryPrecedence must cover every TokenType");
+
+const char *map_expression_parsing_to_string(ExpressionParsing parsing) noexcept
+{
+    switch (parsing)
+    {
+    case ExpressionParsing::RECURSIVE_DESCENT:
+        return "RECURSIVE_DESCENT";
+    case ExpressionParsing::PRECEDENCE_CLIMBING:
+        return "PRECEDENCE_CLIMBING";
+    default:
+        return "UNKNOWN";
+    }
+}
 
-Parser::Parser(Lexer *lexer) : lexer_{lexer}
+Parser::Parser(Lexer *lexer)
+    : lexer_{lexer}, lookahead_{new LookaheadBuffer(lexer)}, interner_{lexer->get_interner()}
 {
-    current_token_ = lexer_->get_next_token();
+    if (interner_ == nullptr)
+    {
+        interner_ = std::make_shared<Interner>();
+    }
+    current_token_ = lookahead_->peek(0);
 }
-Parser::~Parser()
+Parser::Parser(const TokenBuffer *tokens) : tokens_{tokens}, interner_{tokens->get_interner()}
 {
-    // delete current_token_;
+    if (interner_ == nullptr)
+    {
+        interner_ = std::make_shared<Interner>();
+    }
+    current_token_ = (*tokens_)[token_index_];
 }
+Parser::~Parser() {}
 
 AbstractSyntaxTree *Parser::parse()
 {
-    ProgramNode *root_node = _program();
-    AbstractSyntaxTree *ast = new AbstractSyntaxTree(root_node);
-    return ast;
+    /// @note The tree comes first since its arena holds the nodes,
+    /// everything is released at once if parsing fails
+    std::unique_ptr<AbstractSyntaxTree> ast(new AbstractSyntaxTree(interner_));
+    arena_ = &ast->get_arena();
+    current_span_ = kNoParentSpan;
+
+    ast->set_root(_program());
+    arena_ = nullptr;
+    return ast.release();
 }
 
+void Parser::set_statement_spans(std::vector<StatementSpan> *spans) noexcept { spans_ = spans; }
+
+AstNode *Parser::parse_statement(std::size_t first_token, Arena *arena)
+{
+    token_index_ = first_token;
+    current_token_ = (*tokens_)[token_index_];
+    arena_ = arena;
+    current_span_ = kNoParentSpan;
+
+    AstNode *node = _statement();
+    arena_ = nullptr;
+    return node;
+}
+
+std::size_t Parser::get_token_index() const noexcept { return token_index_; }
+
+void Parser::set_main_statements(const std::vector<AstNode *> *statements, std::size_t end_token) noexcept
+{
+    main_statements_ = statements;
+    main_end_token_ = end_token;
+}
+
+void Parser::set_error_mode(ErrorMode mode) noexcept { error_mode_ = mode; }
+const std::vector<Diagnostic> &Parser::get_diagnostics() const noexcept { return diagnostics_; }
+
+void Parser::set_expression_parsing(ExpressionParsing parsing) noexcept { expression_parsing_ = parsing; }
+
 ProgramNode *Parser::_program()
 {
-    eat_and_ignore(TokenType::PROGRAM);
+    std::uint32_t offset = current_token_.get_offset();
+    eat(TokenType::PROGRAM);
 
-    Token *id_token = current_token_;
+    BufferedToken id_token = current_token_;
     eat(TokenType::ID);
-    IdToken *casted_id_token = static_cast<IdToken *>(id_token);
-    /// @note make copy to preventing use-after-free
-    std::string program_name = casted_id_token->get_value();
-    delete casted_id_token;
+    SymbolId program_symbol = (id_token.get_type() == TokenType::ID) ? symbol(id_token) : kInvalidSymbol;
 
-    eat_and_ignore(TokenType::SEMI_COLON);
+    eat(TokenType::SEMI_COLON);
+    if (panicking_)
+    {
+        synchronize(TokenType::VAR, TokenType::BEGIN);
+    }
 
     BlockNode *block_node = _block();
 
-    eat_and_ignore(TokenType::DOT);
+    eat(TokenType::DOT);
 
-    ProgramNode *program_node = new ProgramNode(std::move(program_name), block_node);
+    ProgramNode *program_node = create_node<ProgramNode>(offset, program_symbol, block_node);
     return program_node;
 }
 
 BlockNode *Parser::_block()
 {
-    return new BlockNode(_declarations(), _compound_statement());
+    std::uint32_t offset = current_token_.get_offset();
+    /// @note Function arguments are evaluated in unspecified order,
+    /// declarations must be consumed before the compound statement
+    std::vector<VarDeclNode *> declarations = _declarations();
+    CompoundStatementNode *compound_statement;
+    if (main_statements_ != nullptr)
+    {
+        compound_statement = _main_compound_statement();
+    }
+    else
+    {
+        std::size_t parent_span = open_span();
+        compound_statement = _compound_statement();
+        close_span(parent_span, compound_statement);
+    }
+    return create_node<BlockNode>(offset, arena_->copy_array(declarations.data(), declarations.size()),
+                                  declarations.size(), compound_statement);
 }
 
 std::vector<VarDeclNode *> Parser::_declarations()
 {
     std::vector<VarDeclNode *> decl_list;
-    if (current_token_->get_type() == TokenType::VAR)
+    if (current_token_.get_type() == TokenType::VAR)
     {
-        eat_and_ignore(TokenType::VAR);
-        while (current_token_->get_type() == TokenType::ID)
+        eat(TokenType::VAR);
+        while (current_token_.get_type() == TokenType::ID)
         {
             std::vector<VarDeclNode *> decls = _variable_declaration();
             decl_list.insert(decl_list.end(),
                              std::make_move_iterator(decls.begin()),
                              std::make_move_iterator(decls.end()));
 
-            eat_and_ignore(TokenType::SEMI_COLON);
+            if (panicking_)
+            {
+                synchronize(TokenType::SEMI_COLON, TokenType::BEGIN);
+                if (current_token_.get_type() != TokenType::SEMI_COLON)
+                {
+                    break;
+                }
+            }
+            eat(TokenType::SEMI_COLON);
         }
     }
 
@@ -68,35 +163,24 @@ std::vector<VarDeclNode *> Parser::_declarations()
 
 std::vector<VarDeclNode *> Parser::_variable_declaration()
 {
-    Token *id_token = current_token_;
-    eat(TokenType::ID);
-    /// @note make a copy to prevent potential Use-After-Free
-    std::string id_node_name = std::string((static_cast<IdToken *>(id_token))->get_value());
-    delete id_token;
-
-    std::vector<VariableNode *> var_nodes = {new VariableNode(std::move(id_node_name))};
-    while (current_token_->get_type() != TokenType::COLON)
+    std::vector<VariableNode *> var_nodes = {_variable()};
+    while (current_token_.get_type() == TokenType::COMMA)
     {
-        eat_and_ignore(TokenType::COMMA);
-
-        Token *id_token = current_token_;
-        eat(TokenType::ID);
-        /// @note make a copy to prevent potential Use-After-Free
-        std::string id_node_name = std::string((static_cast<IdToken *>(id_token))->get_value());
-        delete id_token;
-
-        var_nodes.push_back(new VariableNode(std::move(id_node_name)));
+        eat(TokenType::COMMA);
+        var_nodes.push_back(_variable());
     }
 
-    eat_and_ignore(TokenType::COLON);
+    eat(TokenType::COLON);
 
     TypeNode *type_node = _type_spec();
     std::vector<VarDeclNode *> var_decl_nodes;
     for (auto &var_node : var_nodes)
     {
-        var_decl_nodes.push_back(new VarDeclNode(var_node, new TypeNode(*type_node)));
+        /// @note Every declaration has its own type node, all of them share the type token
+        TypeNode *var_type_node = (var_decl_nodes.empty()) ? type_node
+                                                           : create_node<TypeNode>(type_node->get_offset(), *type_node);
+        var_decl_nodes.push_back(create_node<VarDeclNode>(var_node->get_offset(), var_node, var_type_node));
     }
-    delete type_node;
 
     /// @note The compiler applies Return Value Optimization (RVO), no extra move/copy
     return var_decl_nodes;
@@ -104,8 +188,9 @@ std::vector<VarDeclNode *> Parser::_variable_declaration()
 
 TypeNode *Parser::_type_spec()
 {
-    Token *type_token = current_token_;
-    switch (type_token->get_type())
+    std::uint32_t offset = current_token_.get_offset();
+    TokenType type = current_token_.get_type();
+    switch (type)
     {
     case TokenType::INTEGER:
         eat(TokenType::INTEGER);
@@ -114,84 +199,152 @@ TypeNode *Parser::_type_spec()
         eat(TokenType::REAL);
         break;
     default:
-        __THROW_PARSING_ERROR
+        /// @note The node keeps the offending token type, the tree has errors anyway
+        error("a type");
+        break;
     }
 
-    return new TypeNode(type_token);
+    return create_node<TypeNode>(offset, arena_->create<Token>(type));
 }
 
 CompoundStatementNode *Parser::_compound_statement()
 {
-    eat_and_ignore(TokenType::BEGIN);
-    CompoundStatementNode *node = new CompoundStatementNode(std::move(_statement_list()));
-    eat_and_ignore(TokenType::END);
+    std::uint32_t offset = current_token_.get_offset();
+    eat(TokenType::BEGIN);
+    std::vector<AstNode *> statements = _statement_list();
+    CompoundStatementNode *node = create_node<CompoundStatementNode>(
+        offset,
+        arena_->copy_array(statements.data(), statements.size()), statements.size());
+    eat(TokenType::END);
+    return node;
+}
+
+CompoundStatementNode *Parser::_main_compound_statement()
+{
+    std::uint32_t offset = current_token_.get_offset();
+    eat(TokenType::BEGIN);
+    token_index_ = main_end_token_;
+    current_token_ = (*tokens_)[token_index_];
+
+    CompoundStatementNode *node = create_node<CompoundStatementNode>(
+        offset,
+        arena_->copy_array(main_statements_->data(), main_statements_->size()), main_statements_->size());
+    eat(TokenType::END);
     return node;
 }
 
 std::vector<AstNode *> Parser::_statement_list()
 {
-    std::vector<AstNode *> statements = {_statement()};
-    while (current_token_->get_type() == TokenType::SEMI_COLON)
+    std::vector<AstNode *> statements;
+    for (;;)
     {
-        eat_and_ignore(TokenType::SEMI_COLON);
+        /// @note The span of a statement is recorded before the spans nested in it
+        std::size_t span = (spans_ != nullptr) ? spans_->size() : 0;
         statements.push_back(_statement());
+        if (spans_ != nullptr)
+        {
+            (*spans_)[span].index = statements.size() - 1;
+        }
+
+        if (panicking_)
+        {
+            synchronize(TokenType::SEMI_COLON, TokenType::END);
+        }
+        if (current_token_.get_type() == TokenType::END || current_token_.get_type() == TokenType::END_OF_FILE)
+        {
+            break;
+        }
+
+        /// @note Anything else than a separator is either a missing one or garbage,
+        /// both are skipped up to the next separator
+        if (current_token_.get_type() != TokenType::SEMI_COLON)
+        {
+            error(map_token_type_to_string(TokenType::SEMI_COLON));
+            synchronize(TokenType::SEMI_COLON, TokenType::END);
+            if (current_token_.get_type() != TokenType::SEMI_COLON)
+            {
+                break;
+            }
+        }
+        eat(TokenType::SEMI_COLON);
     }
 
-    if (current_token_->get_type() == TokenType::ID)
+    return statements;
+}
+
+std::size_t Parser::open_span()
+{
+    std::size_t parent_span = current_span_;
+    if (spans_ != nullptr)
     {
-        __THROW_PARSING_ERROR
+        current_span_ = spans_->size();
+        spans_->push_back(StatementSpan{nullptr, parent_span, 0, token_index_, token_index_});
     }
+    return parent_span;
+}
 
-    return statements;
+void Parser::close_span(std::size_t parent_span, AstNode *node) noexcept
+{
+    if (spans_ != nullptr)
+    {
+        (*spans_)[current_span_].node = node;
+        (*spans_)[current_span_].end_token = token_index_;
+        current_span_ = parent_span;
+    }
 }
 
 AstNode *Parser::_statement()
 {
-    switch (current_token_->get_type())
+    std::size_t parent_span = open_span();
+
+    AstNode *node;
+    switch (current_token_.get_type())
     {
     case TokenType::BEGIN:
-        return _compound_statement();
+        node = _compound_statement();
+        break;
     case TokenType::ID:
-        return _assignment_statement();
+        node = _assignment_statement();
+        break;
     default:
-        return _empty();
+        node = _empty();
+        break;
     }
+
+    close_span(parent_span, node);
+    return node;
 }
 
 AssignmentStatementNode *Parser::_assignment_statement()
 {
     VariableNode *var_node = _variable();
 
-    eat_and_ignore(TokenType::ASSIGN);
+    std::uint32_t offset = current_token_.get_offset();
+    eat(TokenType::ASSIGN);
 
-    AstNode *expr_node = _expr();
+    AstNode *expr_node = (expression_parsing_ == ExpressionParsing::PRECEDENCE_CLIMBING)
+                             ? _precedence_climbing_expr()
+                             : _expr();
 
-    return new AssignmentStatementNode(var_node, expr_node);
+    return create_node<AssignmentStatementNode>(offset, var_node, expr_node);
 }
 
 NoOperationNode *Parser::_empty()
 {
-    return new NoOperationNode();
+    return create_node<NoOperationNode>(current_token_.get_offset());
 }
 
 AstNode *Parser::_expr()
 {
     AstNode *node = _term();
-    while (current_token_ != nullptr &&
-           (current_token_->get_type() == TokenType::PLUS ||
-            current_token_->get_type() == TokenType::MINUS))
+    while (current_token_.get_type() == TokenType::PLUS ||
+           current_token_.get_type() == TokenType::MINUS)
     {
-        Token *op_token = current_token_;
-        if (op_token->get_type() == TokenType::PLUS)
-        {
-            eat(TokenType::PLUS);
-        }
-        else
-        {
-            eat(TokenType::MINUS);
-        }
+        TokenType op_type = current_token_.get_type();
+        std::uint32_t offset = current_token_.get_offset();
+        eat(op_type);
 
-        node = new BinaryOperatorNode(op_token, node, _term());
+        node = create_node<BinaryOperatorNode>(offset, arena_->create<Token>(op_type), node, _term());
     }
     return node;
 }
@@ -200,26 +353,15 @@ AstNode *Parser::_term()
 {
     AstNode *node = _factor();
 
-    while (current_token_ != nullptr &&
-           (current_token_->get_type() == TokenType::MUL ||
-            current_token_->get_type() == TokenType::INTEGER_DIV ||
-            current_token_->get_type() == TokenType::FLOAT_DIV))
+    while (current_token_.get_type() == TokenType::MUL ||
+           current_token_.get_type() == TokenType::INTEGER_DIV ||
+           current_token_.get_type() == TokenType::FLOAT_DIV)
     {
-        Token *op_token = current_token_;
-        if (op_token->get_type() == TokenType::MUL)
-        {
-            eat(TokenType::MUL);
-        }
-        else if (op_token->get_type() == TokenType::INTEGER_DIV)
-        {
-            eat(TokenType::INTEGER_DIV);
-        }
-        else
-        {
-            eat(TokenType::FLOAT_DIV);
-        }
+        TokenType op_type = current_token_.get_type();
+        std::uint32_t offset = current_token_.get_offset();
+        eat(op_type);
 
-        node = new BinaryOperatorNode(op_token, node, _factor());
+        node = create_node<BinaryOperatorNode>(offset, arena_->create<Token>(op_type), node, _factor());
     }
 
     return node;
@@ -227,77 +369,242 @@ AstNode *Parser::_term()
 
 AstNode *Parser::_factor()
 {
-    Token *token = current_token_;
-    switch (token->get_type())
+    BufferedToken token = current_token_;
+    switch (token.get_type())
     {
     case TokenType::PLUS:
     {
         eat(TokenType::PLUS);
-        return new UnaryOperatorNode(token, _factor());
+        return create_node<UnaryOperatorNode>(token.get_offset(), arena_->create<Token>(TokenType::PLUS), _factor());
     }
     case TokenType::MINUS:
     {
         eat(TokenType::MINUS);
-        return new UnaryOperatorNode(token, _factor());
+        return create_node<UnaryOperatorNode>(token.get_offset(), arena_->create<Token>(TokenType::MINUS), _factor());
+    }
+    case TokenType::LPAREN:
+    {
+        eat(TokenType::LPAREN);
+        AstNode *node = _expr();
+        eat(TokenType::RPAREN);
+        return node;
+    }
+    default:
+    {
+        return _operand();
+    }
     }
+}
+
+AstNode *Parser::_operand()
+{
+    BufferedToken token = current_token_;
+    switch (token.get_type())
+    {
     case TokenType::INTEGER_NUMBER:
     {
         eat(TokenType::INTEGER_NUMBER);
-        return new IntNumNode(static_cast<IntNumToken *>(token));
+        return create_node<IntNumNode>(token.get_offset(), arena_->create<IntNumToken>(token.get_int_value()));
     }
     case TokenType::REAL_NUMBER:
     {
         eat(TokenType::REAL_NUMBER);
-        return new RealNumNode(static_cast<RealNumToken *>(token));
+        return create_node<RealNumNode>(token.get_offset(), arena_->create<RealNumToken>(token.get_real_value()));
     }
-    case TokenType::LPAREN:
+    case TokenType::ID:
     {
-        eat(TokenType::LPAREN);
-        delete token; // delete LPAREN token pointer
+        return _variable();
+    }
+    default:
+    {
+        error("an expression");
+        return create_node<ErrorNode>(token.get_offset());
+    }
+    }
+}
 
-        AstNode *node = _expr();
+AstNode *Parser::_precedence_climbing_expr()
+{
+    /// @note Leftovers of an expression that failed to parse
+    operand_stack_.clear();
+    operator_stack_.clear();
 
-        token = current_token_;
-        eat(TokenType::RPAREN);
-        delete token; // delete RPAREN token pointer
+    std::size_t open_parenthesis_count = 0;
+    bool expect_operand = true;
+    for (;;)
+    {
+        TokenType type = current_token_.get_type();
+        if (expect_operand)
+        {
+            if (type == TokenType::PLUS || type == TokenType::MINUS || type == TokenType::LPAREN)
+            {
+                operator_stack_.push_back(PendingOperator{type, type != TokenType::LPAREN, current_token_.get_offset()});
+                eat(type);
+                open_parenthesis_count += (type == TokenType::LPAREN) ? 1 : 0;
+                continue;
+            }
+
+            operand_stack_.push_back(_operand());
+            reduce_unary_operators();
+            expect_operand = false;
+            continue;
+        }
 
-        return node;
+        unsigned char precedence = kBinaryPrecedence[static_cast<std::size_t>(type)];
+        if (precedence != 0)
+        {
+            /// @note Binary operators are left-associative, equal precedences are built first
+            reduce_binary_operators(precedence);
+            operator_stack_.push_back(PendingOperator{type, false, current_token_.get_offset()});
+            eat(type);
+            expect_operand = true;
+            continue;
+        }
+
+        if (type == TokenType::RPAREN && open_parenthesis_count > 0)
+        {
+            reduce_binary_operators(1);
+            eat(TokenType::RPAREN);
+            operator_stack_.pop_back();
+            --open_parenthesis_count;
+            /// @note A parenthesized expression is a factor, signs before it apply to all of it
+            reduce_unary_operators();
+            continue;
+        }
+
+        break;
     }
-    case TokenType::ID:
+
+    if (open_parenthesis_count > 0)
     {
-        return _variable();
+        /// @note Same failure as *_factor()* expecting the closing parenthesis
+        eat(TokenType::RPAREN);
     }
-    default:
+    reduce_binary_operators(1);
+
+    return operand_stack_.back();
+}
+
+void Parser::reduce_unary_operators()
+{
+    while (!operator_stack_.empty() && operator_stack_.back().is_unary)
     {
-        __THROW_PARSING_ERROR
+        PendingOperator pending = operator_stack_.back();
+        operator_stack_.pop_back();
+        operand_stack_.back() = create_node<UnaryOperatorNode>(pending.offset, arena_->create<Token>(pending.type),
+                                                               operand_stack_.back());
     }
+}
+
+void Parser::reduce_binary_operators(unsigned char precedence)
+{
+    while (!operator_stack_.empty() && !operator_stack_.back().is_unary &&
+           kBinaryPrecedence[static_cast<std::size_t>(operator_stack_.back().type)] >= precedence)
+    {
+        PendingOperator pending = operator_stack_.back();
+        operator_stack_.pop_back();
+
+        AstNode *rhs = operand_stack_.back();
+        operand_stack_.pop_back();
+        operand_stack_.back() = create_node<BinaryOperatorNode>(pending.offset, arena_->create<Token>(pending.type),
+                                                                operand_stack_.back(), rhs);
     }
 }
 
 VariableNode *Parser::_variable()
 {
-    Token *id_token = current_token_;
+    BufferedToken id_token = current_token_;
     eat(TokenType::ID);
-    /// @note make a copy to prevent potential Use-After-Free
-    std::string id_node_name = std::string((static_cast<IdToken *>(id_token))->get_value());
-    delete id_token;
-    return new VariableNode(std::move(id_node_name));
+    return create_node<VariableNode>(id_token.get_offset(),
+                                     (id_token.get_type() == TokenType::ID) ? symbol(id_token) : kInvalidSymbol);
+}
+
+SourceView Parser::lexeme(const BufferedToken &token) const noexcept
+{
+    return (tokens_ != nullptr) ? tokens_->get_lexeme(token) : lexer_->get_lexeme(token);
 }
 
-void Parser::eat_and_ignore(const TokenType &token_type)
+SymbolId Parser::symbol(const BufferedToken &token)
 {
-    Token *token = current_token_;
-    eat(token_type);
-    delete token;
+    SymbolId token_symbol = token.get_symbol();
+    return (token_symbol != kInvalidSymbol) ? token_symbol : interner_->intern(lexeme(token));
+}
+
+void Parser::next_token()
+{
+    if (tokens_ != nullptr)
+    {
+        /// @note The last token of a buffer is END_OF_FILE, never move past it
+        if (token_index_ + 1 < tokens_->size())
+        {
+            token_index_++;
+        }
+        current_token_ = (*tokens_)[token_index_];
+        return;
+    }
+
+    lookahead_->advance();
+    current_token_ = lookahead_->peek(0);
+}
+
+const BufferedToken &Parser::peek(std::size_t k)
+{
+    if (tokens_ != nullptr)
+    {
+        std::size_t index = token_index_ + k;
+        return (*tokens_)[(index < tokens_->size()) ? index : tokens_->size() - 1];
+    }
+
+    return lookahead_->peek(k);
 }
 
 void Parser::eat(const TokenType &token_type)
 {
-    if (current_token_ != nullptr && current_token_->get_type() == token_type)
+    if (current_token_.get_type() == token_type)
     {
-        current_token_ = lexer_->get_next_token();
+        next_token();
         return;
     }
 
-    __THROW_PARSING_ERROR
-}
\ No newline at end of file
+    error(map_token_type_to_string(token_type));
+}
+
+void Parser::error(const std::string &expected)
+{
+    if (error_mode_ == ErrorMode::THROW)
+    {
+        __THROW_PARSING_ERROR
+    }
+
+    if (!panicking_)
+    {
+        diagnostics_.emplace_back(current_token_.get_offset(),
+                                  "Expected " + expected + ", found " + map_token_type_to_string(current_token_.get_type()),
+                                  DiagnosticSeverity::ERROR);
+        panicking_ = true;
+    }
+}
+
+void Parser::synchronize(TokenType separator, TokenType terminator)
+{
+    std::size_t depth = 0;
+    for (TokenType type = current_token_.get_type(); type != TokenType::END_OF_FILE; type = current_token_.get_type())
+    {
+        if (depth == 0 && (type == separator || type == terminator))
+        {
+            break;
+        }
+
+        if (type == TokenType::BEGIN)
+        {
+            ++depth;
+        }
+        else if (type == TokenType::END && depth > 0)
+        {
+            --depth;
+        }
+        next_token();
+    }
+
+    panicking_ = false;
+}
@@ -1,29 +1,147 @@
 #ifndef PARSER_HPP
 #define PARSER_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 #include "parser.hpp"
+#include "diagnostic.hpp"
 #include "lexer.hpp"
+#include "lookahead_buffer.hpp"
 #include "token.hpp"
+#include "token_buffer.hpp"
+#include "arena.hpp"
 #include "ast.hpp"
 #include "ast_node.hpp"
 
 #define __THROW_PARSING_ERROR \
     throw std::runtime_error("Error parsing input");
 
-/// @brief A simple recursive-descent parser
+/// @brief Algorithm parsing expressions
+enum class ExpressionParsing : unsigned char
+{
+    /// @brief One function per precedence level (expr, term, factor),
+    /// recursing for every level, parenthesis and unary sign
+    RECURSIVE_DESCENT,
+    /// @brief Table-driven precedence climbing over explicit operand/operator stacks,
+    /// the nesting depth of an expression is only bounded by memory
+    PRECEDENCE_CLIMBING
+};
+
+const char *map_expression_parsing_to_string(ExpressionParsing parsing) noexcept;
+
+/// @brief Marks the compound statement of the program block (or a statement parsed alone)
+/// in *StatementSpan::parent*
+constexpr std::size_t kNoParentSpan = SIZE_MAX;
+
+/// @brief Tokens a statement was parsed from, recorded for incremental re-parsing
+struct StatementSpan
+{
+    AstNode *node;
+    /// @brief Index of the span of the enclosing compound statement,
+    /// *kNoParentSpan* for the compound statement of the block
+    std::size_t parent;
+    /// @brief Position of *node* in the statement list of its compound statement
+    std::size_t index;
+    /// @brief Token range [first_token, end_token) of *node* in the *TokenBuffer*
+    std::size_t first_token;
+    std::size_t end_token;
+};
+
+/// @brief Parser of a program: recursive descent for statements, precedence climbing over
+/// explicit stacks for expressions by default (see *ExpressionParsing*)
 class Parser
 {
 public:
+    /// @brief Pull tokens from *lexer*, scanned in batches into a *LookaheadBuffer*
+    /// @note Identifiers are interned into the interner of the lexer (or a new one if it has none)
     explicit Parser(Lexer *lexer);
+    /// @brief Consume an already tokenized program by index
+    /// @note Identifiers are interned into the interner of the buffer (or a new one if it has none)
+    explicit Parser(const TokenBuffer *tokens);
     ~Parser();
 
     /// @brief Create AST from source code
     AbstractSyntaxTree *parse();
 
+    /// @brief Record the span of every statement parsed from now on into *spans*,
+    /// in pre-order (enclosing statements first), or stop recording with nullptr
+    /// @note The compound statement of the program block gets a span too, the first one
+    /// @note Only meaningful when parsing a *TokenBuffer*
+    void set_statement_spans(std::vector<StatementSpan> *spans) noexcept;
+    /// @brief Parse a single statement starting at token *first_token* of the buffer,
+    /// its nodes are created in *arena* (e.g. the one of the tree it is meant for)
+    /// @note *get_token_index()* tells where the statement ended
+    AstNode *parse_statement(std::size_t first_token, Arena *arena);
+    /// @brief Index of the current token in the *TokenBuffer*
+    std::size_t get_token_index() const noexcept;
+
+    /// @brief Use *statements* as the statements of the compound statement of the program block
+    /// instead of parsing them, the parser skips right to its END token at index *end_token*,
+    /// or parse them again with nullptr
+    /// @note Only meaningful when parsing a *TokenBuffer*. Meant for statements parsed
+    /// elsewhere (see *ParallelParser*), their spans are not recorded.
+    void set_main_statements(const std::vector<AstNode *> *statements, std::size_t end_token) noexcept;
+
+    /// @brief With *ErrorMode::COLLECT*, *parse()* never throws on invalid code: every
+    /// syntax error is reported in *get_diagnostics()*, parsing resumes at the next `;`
+    /// or END of the enclosing statement list (next `;` or BEGIN in declarations), and
+    /// expressions that failed to parse are replaced by an *ErrorNode*
+    /// @note *ErrorMode::THROW* by default. The error mode of a *Lexer* is set separately.
+    void set_error_mode(ErrorMode mode) noexcept;
+    /// @brief Syntax errors found so far, in source order
+    const std::vector<Diagnostic> &get_diagnostics() const noexcept;
+
+    /// @brief Choose how expressions are parsed, both build the same tree
+    /// @note *ExpressionParsing::PRECEDENCE_CLIMBING* by default
+    void set_expression_parsing(ExpressionParsing parsing) noexcept;
+
 private:
-    Lexer *lexer_;
-    Token *current_token_ = nullptr;
+    /// @brief Token source in pull mode, nullptr when parsing a *TokenBuffer*
+    Lexer *lexer_ = nullptr;
+    /// @brief Upcoming tokens of lexer_ in pull mode, nullptr when parsing a *TokenBuffer*
+    std::unique_ptr<LookaheadBuffer> lookahead_;
+    /// @brief Token source in buffer mode, nullptr when pulling from a *Lexer*
+    const TokenBuffer *tokens_ = nullptr;
+    /// @brief Index of current_token_ in tokens_
+    std::size_t token_index_ = 0;
+    BufferedToken current_token_;
+    /// @brief Interner shared with the produced AST
+    std::shared_ptr<Interner> interner_;
+    /// @brief Arena of the tree being built
+    Arena *arena_ = nullptr;
+    /// @brief Recorded statement spans, nullptr when not recording
+    std::vector<StatementSpan> *spans_ = nullptr;
+    /// @brief Span of the innermost statement being parsed
+    std::size_t current_span_ = kNoParentSpan;
+
+    ErrorMode error_mode_ = ErrorMode::THROW;
+    std::vector<Diagnostic> diagnostics_;
+    /// @brief An error was reported and the parser did not resynchronize yet,
+    /// further errors are most likely consequences of the first one and are not reported
+    bool panicking_ = false;
+
+    /// @brief Statements of the program block parsed elsewhere, nullptr to parse them
+    const std::vector<AstNode *> *main_statements_ = nullptr;
+    /// @brief Index of the END token closing main_statements_
+    std::size_t main_end_token_ = 0;
+
+    /// @brief Operator waiting for its operands in *_precedence_climbing_expr()*
+    struct PendingOperator
+    {
+        /// @brief Operator token, or LPAREN for an open parenthesis
+        TokenType type;
+        bool is_unary;
+        std::uint32_t offset;
+    };
+
+    ExpressionParsing expression_parsing_ = ExpressionParsing::PRECEDENCE_CLIMBING;
+    /// @brief Stacks of *_precedence_climbing_expr()*, kept to reuse their storage
+    std::vector<AstNode *> operand_stack_;
+    std::vector<PendingOperator> operator_stack_;
 
     /// @brief Handle program node
     /// @note ```ebnf
@@ -62,6 +180,8 @@ private:
     /// compound_statement : BEGIN statement_list END
     /// ```
     CompoundStatementNode *_compound_statement();
+    /// @brief Same as *_compound_statement()* over the statements of main_statements_
+    CompoundStatementNode *_main_compound_statement();
 
     /// @brief Handle statement_list node
     /// @note ```ebnf
@@ -113,18 +233,67 @@ private:
     /// ```
     AstNode *_factor();
 
+    /// @brief Handle operand of an expression (leaf of factor)
+    /// @note ```ebnf
+    /// operand : INTEGER_NUMBER
+    ///         | REAL_NUMBER
+    ///         | variable
+    /// ```
+    AstNode *_operand();
+
+    /// @brief Handle expr node like *_expr()*, without recursion
+    /// @note Binary operators bind by their precedence in a table, unary signs bind to the
+    /// next operand or parenthesized expression, so the tree is the one *_expr()* builds.
+    AstNode *_precedence_climbing_expr();
+    /// @brief Build the unary operators on top of the operator stack around the top operand
+    void reduce_unary_operators();
+    /// @brief Build the binary operators on top of the operator stack binding at least
+    /// as tightly as *precedence*, stopping at an open parenthesis
+    void reduce_binary_operators(unsigned char precedence);
+
+    /// @brief Start recording the span of a statement starting at the current token
+    /// @return Span of the enclosing statement, to pass to *close_span()*
+    std::size_t open_span();
+    /// @brief Finish the span of *node* opened by *open_span()*
+    void close_span(std::size_t parent_span, AstNode *node) noexcept;
+
     /// @brief Handle variable node
     /// @note ```ebnf
     /// variable : ID
     /// ```
     VariableNode *_variable();
 
-    /// @brief Eat the current token without adding to AST
-    void eat_and_ignore(const TokenType &token_type);
+    /// @brief Create a node in the arena of the tree, located at *offset* in the source
+    template <typename TNode, typename... TArgs>
+    TNode *create_node(std::uint32_t offset, TArgs &&...args)
+    {
+        TNode *node = arena_->create<TNode>(std::forward<TArgs>(args)...);
+        node->set_offset(offset);
+        return node;
+    }
+
+    /// @brief Slice of the source holding the lexeme of an identifier token
+    SourceView lexeme(const BufferedToken &token) const noexcept;
+    /// @brief Interned name of an identifier token
+    SymbolId symbol(const BufferedToken &token);
+
+    /// @brief Move current_token_ to the next token of the token source
+    void next_token();
+    /// @brief Token *k* positions ahead of current_token_ (itself for 0), without consuming anything
+    /// @note Lets the grammar decide between alternatives without backtracking.
+    /// In pull mode *k* must be lower than *kLookaheadCapacity*, past the end it is END_OF_FILE.
+    const BufferedToken &peek(std::size_t k);
+
+    /// @brief Report that *expected* was expected instead of the current token,
+    /// throws with *ErrorMode::THROW*
+    void error(const std::string &expected);
+    /// @brief Skip tokens up to *separator* or *terminator* (or END_OF_FILE), stepping over
+    /// nested BEGIN ... END blocks, and stop panicking
+    void synchronize(TokenType separator, TokenType terminator);
 
     /// @brief compare the current token type with the passed token
     /// type and if they match then "eat" the current token
-    /// and assign the next token to the self._current_token,
+    /// and assign the next token to the current_token_,
     /// otherwise raise and exception
     void eat(const TokenType &token_type);
 };
@@ -0,0 +1,85 @@
+#include "position_table.hpp"
+#include <cstddef>
+#include <cstdint>
+
+constexpr std::size_t PositionTable::kCheckpointInterval;
+
+void PositionTable::push_back(std::uint32_t offset)
+{
+    if (size_ % kCheckpointInterval == 0)
+    {
+        checkpoints_.push_back(Checkpoint{offset, static_cast<std::uint32_t>(bytes_.size())});
+    }
+    else
+    {
+        /// @note Zigzag: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+        std::int64_t delta = static_cast<std::int64_t>(offset) - static_cast<std::int64_t>(last_offset_);
+        std::uint64_t zigzag = (delta >= 0) ? static_cast<std::uint64_t>(delta) << 1
+                                            : (static_cast<std::uint64_t>(-delta) << 1) - 1;
+        while (zigzag >= 0x80)
+        {
+            bytes_.push_back(static_cast<std::uint8_t>(zigzag | 0x80));
+            zigzag >>= 7;
+        }
+        bytes_.push_back(static_cast<std::uint8_t>(zigzag));
+    }
+
+    last_offset_ = offset;
+    size_++;
+}
+
+/// @brief Decode the delta at *byte* and move past it
+static std::int64_t read_delta(const std::uint8_t *&byte) noexcept
+{
+    std::uint64_t zigzag = 0;
+    for (int shift = 0;; shift += 7)
+    {
+        zigzag |= static_cast<std::uint64_t>(*byte & 0x7f) << shift;
+        if ((*byte++ & 0x80) == 0)
+        {
+            break;
+        }
+    }
+    return (zigzag & 1) ? -static_cast<std::int64_t>((zigzag + 1) >> 1) : static_cast<std::int64_t>(zigzag >> 1);
+}
+
+std::uint32_t PositionTable::operator[](std::size_t index) const noexcept
+{
+    const Checkpoint &checkpoint = checkpoints_[index / kCheckpointInterval];
+    std::int64_t offset = checkpoint.offset;
+    const std::uint8_t *byte = bytes_.data() + checkpoint.byte;
+
+    for (std::size_t remaining = index % kCheckpointInterval; remaining > 0; remaining--)
+    {
+        offset += read_delta(byte);
+    }
+
+    return static_cast<std::uint32_t>(offset);
+}
+
+std::vector<std::uint32_t> PositionTable::decode() const
+{
+    std::vector<std::uint32_t> offsets(size_);
+    std::int64_t offset = 0;
+    const std::uint8_t *byte = bytes_.data();
+    for (std::size_t index = 0; index < size_; index++)
+    {
+        if (index % kCheckpointInterval == 0)
+        {
+            const Checkpoint &checkpoint = checkpoints_[index / kCheckpointInterval];
+            offset = checkpoint.offset;
+            byte = bytes_.data() + checkpoint.byte;
+        }
+        else
+        {
+            offset += read_delta(byte);
+        }
+        offsets[index] = static_cast<std::uint32_t>(offset);
+    }
+    return offsets;
+}
+
+std::size_t PositionTable::get_footprint() const noexcept
+{
+    return bytes_.size() * sizeof(std::uint8_t) + checkpoints_.size() * sizeof(Checkpoint);
+}
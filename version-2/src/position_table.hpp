@@ -0,0 +1,46 @@
+#ifndef POSITION_TABLE_HPP
+#define POSITION_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief Source offsets of a sequence of items (tokens, nodes, ...) identified by
+/// their dense index, stored as variable-length deltas.
+/// @note Every offset is encoded as the zigzag varint of its difference with the previous
+/// one, so offsets close to each other (in either direction) take a single byte. Every
+/// *kCheckpointInterval* items the absolute offset is kept aside, a lookup decodes at most
+/// *kCheckpointInterval* - 1 deltas.
+class PositionTable
+{
+public:
+    static constexpr std::size_t kCheckpointInterval = 32;
+
+    /// @brief Record the offset of the next item, its index is *size()* before the call
+    void push_back(std::uint32_t offset);
+    /// @brief Offset of item *index*
+    std::uint32_t operator[](std::size_t index) const noexcept;
+    /// @brief Offsets of every item, decoded in a single pass
+    std::vector<std::uint32_t> decode() const;
+
+    std::size_t size() const noexcept { return size_; }
+    /// @brief Bytes used by the encoded offsets and the checkpoints
+    std::size_t get_footprint() const noexcept;
+
+private:
+    struct Checkpoint
+    {
+        std::uint32_t offset;
+        /// @brief Position in bytes_ of the delta of the next item
+        std::uint32_t byte;
+    };
+
+    std::vector<std::uint8_t> bytes_;
+    std::vector<Checkpoint> checkpoints_;
+    std::size_t size_ = 0;
+    std::uint32_t last_offset_ = 0;
+
+    friend class AstFile;
+};
+
+#endif
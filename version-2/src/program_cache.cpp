@@ -0,0 +1,145 @@
+#include "program_cache.hpp"
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include "ast.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "semantic_analyzer.hpp"
+#include "token_buffer.hpp"
+
+std::uint64_t hash_program(SourceView source) noexcept
+{
+    constexpr std::uint64_t kMultiplier = 0x9e3779b97f4a7c15ull;
+    const char *data = source.data();
+    std::size_t length = source.length();
+
+    std::uint64_t result = length * kMultiplier;
+    std::size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= length; i += sizeof(std::uint64_t))
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        word *= kMultiplier;
+        result = (result ^ (word ^ (word >> 29))) * kMultiplier;
+    }
+    if (i < length)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data + i, length - i);
+        word *= kMultiplier;
+        result = (result ^ (word ^ (word >> 29))) * kMultiplier;
+    }
+
+    /// @note Final mix, so that the low bits used by the hash table depend on every character
+    result ^= result >> 32;
+    result *= kMultiplier;
+    return result ^ (result >> 29);
+}
+
+CompiledProgram::CompiledProgram(SourceView source)
+{
+    Lexer lexer(source);
+    TokenBuffer tokens = lexer.tokenize();
+    Parser parser(&tokens);
+    std::unique_ptr<AbstractSyntaxTree> ast(parser.parse());
+    SemanticAnalyzer analyzer(ast.get());
+    if (!analyzer.analyze())
+    {
+        __THROW_ANALYZING_ERROR(analyzer)
+    }
+    program_ = RegisterCompiler(analyzer).compile();
+
+    footprint_ = program_.code.size() * sizeof(RegisterInstruction) + program_.constants.size() * sizeof(Cell) +
+                 program_.variables.size() * sizeof(VariableSymbol) +
+                 program_.locations.size() * sizeof(InstructionLocation) + program_.interner->get_footprint() +
+                 source.length() + sizeof(*this);
+}
+
+ProgramCache::ProgramCache(std::size_t capacity) : capacity_{capacity} {}
+
+std::list<ProgramCache::Entry>::iterator ProgramCache::find(std::uint64_t hash, SourceView source)
+{
+    auto position = index_.find(hash);
+    if (position == index_.end())
+    {
+        return entries_.end();
+    }
+
+    const std::string &cached_source = position->second->source;
+    bool is_same_source = cached_source.length() == source.length() &&
+                          std::memcmp(cached_source.data(), source.data(), source.length()) == 0;
+    return is_same_source ? position->second : entries_.end();
+}
+
+void ProgramCache::erase(std::list<Entry>::iterator position)
+{
+    stats_.bytes -= position->program->get_footprint();
+    --stats_.entry_count;
+    index_.erase(position->hash);
+    entries_.erase(position);
+}
+
+std::shared_ptr<const CompiledProgram> ProgramCache::get(SourceView source)
+{
+    std::uint64_t hash = hash_program(source);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto position = find(hash, source);
+        if (position != entries_.end())
+        {
+            ++stats_.hits;
+            entries_.splice(entries_.begin(), entries_, position);
+            return position->program;
+        }
+        ++stats_.misses;
+    }
+
+    std::shared_ptr<const CompiledProgram> program = std::make_shared<CompiledProgram>(source);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto position = find(hash, source);
+    if (position != entries_.end())
+    {
+        /// @note Another thread compiled the same source meanwhile, keep a single copy
+        entries_.splice(entries_.begin(), entries_, position);
+        return position->program;
+    }
+    if (program->get_footprint() > capacity_)
+    {
+        return program;
+    }
+
+    /// @note A different source with the same hash is replaced, the most recent one wins
+    auto colliding = index_.find(hash);
+    if (colliding != index_.end())
+    {
+        erase(colliding->second);
+    }
+    while (stats_.bytes + program->get_footprint() > capacity_)
+    {
+        erase(std::prev(entries_.end()));
+        ++stats_.evictions;
+    }
+
+    entries_.push_front(Entry{hash, source.to_string(), program});
+    index_.emplace(hash, entries_.begin());
+    stats_.bytes += program->get_footprint();
+    ++stats_.entry_count;
+    return program;
+}
+
+ProgramCacheStats ProgramCache::get_stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void ProgramCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    stats_.entry_count = 0;
+    stats_.bytes = 0;
+}
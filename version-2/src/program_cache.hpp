@@ -0,0 +1,102 @@
+#ifndef PROGRAM_CACHE_HPP
+#define PROGRAM_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "register_vm.hpp"
+#include "source.hpp"
+
+/// @brief Default number of bytes of compiled programs kept by a *ProgramCache*
+constexpr std::size_t kDefaultProgramCacheCapacity = 64 * 1024 * 1024;
+
+/// @brief 64-bit hash of the content of a program, reading it 8 characters at a time
+std::uint64_t hash_program(SourceView source) noexcept;
+
+/// @brief Program compiled once and shared, read-only, by every execution of its source
+/// @note Every execution runs its own *RegisterVm* (holding the registers) over the program:
+/// ```cpp
+/// RegisterVm vm(&cache.get(source)->get_program());
+/// vm.run();
+/// ```
+class CompiledProgram
+{
+public:
+    /// @brief Tokenize, parse, analyze and compile *source* for a *RegisterVm*
+    /// @note Throws like *Parser::parse()* on invalid code, and with the first semantic error
+    /// if the analysis found some
+    explicit CompiledProgram(SourceView source);
+
+    CompiledProgram(const CompiledProgram &) = delete;
+    CompiledProgram &operator=(const CompiledProgram &) = delete;
+
+    /// @brief Register code, with its variables and the interner naming them
+    const RegisterProgram &get_program() const noexcept { return program_; }
+    /// @brief Bytes charged to the cache for this program (code, variables, names and cache key)
+    std::size_t get_footprint() const noexcept { return footprint_; }
+
+private:
+    RegisterProgram program_;
+    std::size_t footprint_;
+};
+
+/// @brief Counters of a *ProgramCache*
+struct ProgramCacheStats
+{
+    std::size_t hits;
+    std::size_t misses;
+    std::size_t evictions;
+    std::size_t entry_count;
+    std::size_t bytes;
+};
+
+/// @brief Thread-safe cache of compiled programs keyed by the content of their source,
+/// evicting the least recently used ones beyond a capacity in bytes
+/// @note Programs are handed out as shared pointers to const: an evicted program stays
+/// alive as long as an execution still uses it, and executions never modify it, so any
+/// number of threads can run the same program at once.
+/// Compiling happens outside the lock, a miss does not block hits on other programs.
+class ProgramCache
+{
+public:
+    explicit ProgramCache(std::size_t capacity = kDefaultProgramCacheCapacity);
+
+    ProgramCache(const ProgramCache &) = delete;
+    ProgramCache &operator=(const ProgramCache &) = delete;
+
+    /// @brief Compiled program of *source*, compiled on a miss
+    /// @note A program larger than the whole capacity is compiled but not kept.
+    /// Throws like *CompiledProgram()* on invalid code, nothing is cached then.
+    std::shared_ptr<const CompiledProgram> get(SourceView source);
+
+    ProgramCacheStats get_stats() const;
+    /// @brief Drop every program (the ones in use stay alive)
+    void clear();
+
+private:
+    struct Entry
+    {
+        std::uint64_t hash;
+        /// @brief Copy of the source, to tell programs with colliding hashes apart
+        std::string source;
+        std::shared_ptr<const CompiledProgram> program;
+    };
+
+    std::size_t capacity_;
+    mutable std::mutex mutex_;
+    /// @brief Most recently used first
+    std::list<Entry> entries_;
+    std::unordered_map<std::uint64_t, std::list<Entry>::iterator> index_;
+    ProgramCacheStats stats_ = {};
+
+    /// @brief Entry of *source*, entries_.end() if it is not cached, with mutex_ held
+    std::list<Entry>::iterator find(std::uint64_t hash, SourceView source);
+    /// @brief Remove the entry at *position*, with mutex_ held
+    void erase(std::list<Entry>::iterator position);
+};
+
+#endif
@@ -0,0 +1,498 @@
+#include "register_vm.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include "ast.hpp"
+#include "dispatch.hpp"
+#include "token.hpp"
+
+/// @brief Flag of a virtual temporary until registers are allocated
+constexpr RegisterIndex kVirtualTemporary = 0x80000000u;
+
+const char *map_register_opcode_to_string(RegisterOpcode opcode) noexcept
+{
+    switch (opcode)
+    {
+    case RegisterOpcode::MOVE:
+        return "MOVE";
+    case RegisterOpcode::INTEGER_ADD:
+        return "INTEGER_ADD";
+    case RegisterOpcode::INTEGER_SUBTRACT:
+        return "INTEGER_SUBTRACT";
+    case RegisterOpcode::INTEGER_MULTIPLY:
+        return "INTEGER_MULTIPLY";
+    case RegisterOpcode::INTEGER_DIVIDE:
+        return "INTEGER_DIVIDE";
+    case RegisterOpcode::INTEGER_NEGATE:
+        return "INTEGER_NEGATE";
+    case RegisterOpcode::REAL_ADD:
+        return "REAL_ADD";
+    case RegisterOpcode::REAL_SUBTRACT:
+        return "REAL_SUBTRACT";
+    case RegisterOpcode::REAL_MULTIPLY:
+        return "REAL_MULTIPLY";
+    case RegisterOpcode::REAL_DIVIDE:
+        return "REAL_DIVIDE";
+    case RegisterOpcode::REAL_NEGATE:
+        return "REAL_NEGATE";
+    case RegisterOpcode::INTEGER_TO_REAL:
+        return "INTEGER_TO_REAL";
+    case RegisterOpcode::HALT:
+        return "HALT";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+/// @brief Instruction of a binary *operation*
+static RegisterOpcode binary_opcode(Operation operation) noexcept
+{
+    switch (operation)
+    {
+    case Operation::INTEGER_ADD:
+        return RegisterOpcode::INTEGER_ADD;
+    case Operation::INTEGER_SUBTRACT:
+        return RegisterOpcode::INTEGER_SUBTRACT;
+    case Operation::INTEGER_MULTIPLY:
+        return RegisterOpcode::INTEGER_MULTIPLY;
+    case Operation::INTEGER_DIVIDE:
+        return RegisterOpcode::INTEGER_DIVIDE;
+    case Operation::REAL_ADD:
+        return RegisterOpcode::REAL_ADD;
+    case Operation::REAL_SUBTRACT:
+        return RegisterOpcode::REAL_SUBTRACT;
+    case Operation::REAL_MULTIPLY:
+        return RegisterOpcode::REAL_MULTIPLY;
+    default:
+        return RegisterOpcode::REAL_DIVIDE;
+    }
+}
+
+// MARK: Compiler
+
+RegisterCompiler::RegisterCompiler(const SemanticAnalyzer &analyzer) : analyzer_{analyzer}
+{
+    if (analyzer.has_errors())
+    {
+        __THROW_COMPILING_ERROR
+    }
+}
+
+RegisterProgram RegisterCompiler::compile()
+{
+    program_ = RegisterProgram();
+    program_.variables = analyzer_.get_variables();
+    program_.interner = analyzer_.get_ast()->get_interner();
+    integer_constants_.clear();
+    real_constants_.clear();
+    intervals_.clear();
+    versions_.assign(program_.variables.size(), 0);
+    available_.assign(kAvailableCapacity, AvailableExpression{{}, kNoRegister, 0});
+
+    visit(analyzer_.get_ast()->get_root());
+    emit(RegisterOpcode::HALT, kNoRegister, kNoRegister);
+    allocate_registers();
+    return std::move(program_);
+}
+
+void RegisterCompiler::emit(RegisterOpcode opcode, RegisterIndex destination, RegisterIndex lhs, RegisterIndex rhs)
+{
+    program_.code.push_back(RegisterInstruction{opcode, destination, lhs, rhs});
+    if (destination < versions_.size())
+    {
+        ++versions_[destination];
+    }
+}
+
+std::size_t RegisterCompiler::hash_expression(const Expression &expression, std::size_t capacity) noexcept
+{
+    std::uint64_t hash = static_cast<std::uint64_t>(expression.opcode);
+    for (std::uint32_t field : {expression.lhs, expression.rhs, expression.lhs_version, expression.rhs_version})
+    {
+        hash = (hash ^ field) * 0x9E3779B97F4A7C15ull;
+    }
+    return static_cast<std::size_t>(hash >> 32) & (capacity - 1);
+}
+
+std::uint32_t RegisterCompiler::get_version(RegisterIndex source) const noexcept
+{
+    return (source < versions_.size()) ? versions_[source] : 0;
+}
+
+RegisterIndex RegisterCompiler::compute(RegisterOpcode opcode, RegisterIndex destination, RegisterIndex lhs,
+                                        RegisterIndex rhs, const AstNode *node)
+{
+    RegisterIndex first = lhs;
+    RegisterIndex second = rhs;
+    bool is_commutative = opcode == RegisterOpcode::INTEGER_ADD || opcode == RegisterOpcode::INTEGER_MULTIPLY ||
+                          opcode == RegisterOpcode::REAL_ADD || opcode == RegisterOpcode::REAL_MULTIPLY;
+    if (is_commutative && second < first)
+    {
+        std::swap(first, second);
+    }
+    Expression expression{opcode, first, second, get_version(first), get_version(second)};
+
+    AvailableExpression &available = available_[hash_expression(expression, available_.size())];
+    if (available.source != kNoRegister && available.expression == expression &&
+        available.version == get_version(available.source))
+    {
+        return move(destination, available.source);
+    }
+
+    RegisterIndex result = target(destination);
+    if (opcode == RegisterOpcode::INTEGER_DIVIDE)
+    {
+        program_.locations.push_back({static_cast<std::uint32_t>(program_.code.size()), node->get_offset()});
+    }
+    emit(opcode, result, use(lhs), use(rhs));
+    available = AvailableExpression{expression, result, get_version(result)};
+    return result;
+}
+
+RegisterIndex RegisterCompiler::target(RegisterIndex destination)
+{
+    if (destination != kNoRegister)
+    {
+        return destination;
+    }
+    /// @note The temporary is defined by the next instruction
+    intervals_.push_back(LiveInterval{program_.code.size(), program_.code.size()});
+    return kVirtualTemporary | static_cast<RegisterIndex>(intervals_.size() - 1);
+}
+
+RegisterIndex RegisterCompiler::use(RegisterIndex source)
+{
+    if ((source & kVirtualTemporary) != 0 && source != kNoRegister)
+    {
+        intervals_[source & ~kVirtualTemporary].end = program_.code.size();
+    }
+    return source;
+}
+
+RegisterIndex RegisterCompiler::move(RegisterIndex destination, RegisterIndex source)
+{
+    if (destination == kNoRegister || destination == source)
+    {
+        return source;
+    }
+    emit(RegisterOpcode::MOVE, destination, use(source));
+    return destination;
+}
+
+RegisterIndex RegisterCompiler::integer_constant(int value)
+{
+    auto inserted = integer_constants_.emplace(value, static_cast<std::uint32_t>(program_.constants.size()));
+    if (inserted.second)
+    {
+        Cell cell;
+        cell.integer = value;
+        program_.constants.push_back(cell);
+    }
+    return static_cast<RegisterIndex>(program_.variables.size() + inserted.first->second);
+}
+
+RegisterIndex RegisterCompiler::real_constant(double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    auto inserted = real_constants_.emplace(bits, static_cast<std::uint32_t>(program_.constants.size()));
+    if (inserted.second)
+    {
+        Cell cell;
+        cell.real = value;
+        program_.constants.push_back(cell);
+    }
+    return static_cast<RegisterIndex>(program_.variables.size() + inserted.first->second);
+}
+
+void RegisterCompiler::visit_block(BlockNode *node)
+{
+    /// @note Declarations were handled by the analyzer
+    visit(node->get_compound_statement_node());
+}
+
+void RegisterCompiler::visit_assignment_statement(AssignmentStatementNode *node)
+{
+    /// @note The last operation writes straight to the variable, there is no store
+    compile_expression(node->get_rhs(), node->get_lhs()->get_slot());
+}
+
+RegisterIndex RegisterCompiler::compile_expression(AstNode *node, RegisterIndex destination)
+{
+    /// @note Unary pluses compile to nothing, the destination goes to the node under them
+    AstNode *last = node;
+    while (!last->is_promoted() && (last->get_operation() == Operation::INTEGER_IDENTITY ||
+                                    last->get_operation() == Operation::REAL_IDENTITY))
+    {
+        last = static_cast<UnaryOperatorNode *>(last)->get_rhs();
+    }
+
+    registers_.clear();
+    walker_.walk(node, [&](AstNode *node) {
+        RegisterIndex result = compile_node(node, (node == last) ? destination : kNoRegister);
+        registers_.push_back(result);
+    });
+    return registers_.back();
+}
+
+RegisterIndex RegisterCompiler::compile_node(AstNode *node, RegisterIndex destination)
+{
+    Operation operation = node->get_operation();
+    if (node->is_promoted() && operation == Operation::INTEGER_CONSTANT)
+    {
+        /// @note Promoted at compile time
+        return move(destination, real_constant(static_cast<IntNumNode *>(node)->get_token()->get_value()));
+    }
+
+    /// @note A promoted value is computed anywhere, its conversion goes to the destination
+    RegisterIndex value_destination = node->is_promoted() ? kNoRegister : destination;
+    RegisterIndex value;
+    switch (operation)
+    {
+    case Operation::INTEGER_CONSTANT:
+        value = move(value_destination, integer_constant(static_cast<IntNumNode *>(node)->get_token()->get_value()));
+        break;
+    case Operation::REAL_CONSTANT:
+        value = move(value_destination, real_constant(static_cast<RealNumNode *>(node)->get_token()->get_value()));
+        break;
+    case Operation::INTEGER_LOAD:
+    case Operation::REAL_LOAD:
+        value = move(value_destination, static_cast<VariableNode *>(node)->get_slot());
+        break;
+    case Operation::INTEGER_ADD:
+    case Operation::INTEGER_SUBTRACT:
+    case Operation::INTEGER_MULTIPLY:
+    case Operation::INTEGER_DIVIDE:
+    case Operation::REAL_ADD:
+    case Operation::REAL_SUBTRACT:
+    case Operation::REAL_MULTIPLY:
+    case Operation::REAL_DIVIDE:
+    {
+        RegisterIndex rhs = pop_register();
+        RegisterIndex lhs = pop_register();
+        value = compute(binary_opcode(operation), value_destination, lhs, rhs, node);
+        break;
+    }
+    case Operation::INTEGER_NEGATE:
+    case Operation::REAL_NEGATE:
+        value = compute((operation == Operation::REAL_NEGATE) ? RegisterOpcode::REAL_NEGATE
+                                                              : RegisterOpcode::INTEGER_NEGATE,
+                        value_destination, pop_register(), kNoRegister, node);
+        break;
+    case Operation::INTEGER_IDENTITY:
+    case Operation::REAL_IDENTITY:
+        /// @note Unary plus compiles to nothing, it holds the register of its operand
+        value = pop_register();
+        break;
+    default:
+        __THROW_COMPILING_ERROR
+    }
+
+    return node->is_promoted() ? compute(RegisterOpcode::INTEGER_TO_REAL, destination, value, kNoRegister, node)
+                               : value;
+}
+
+RegisterIndex RegisterCompiler::pop_register() noexcept
+{
+    RegisterIndex source = registers_.back();
+    registers_.pop_back();
+    return source;
+}
+
+void RegisterCompiler::allocate_registers()
+{
+    /// @note Intervals are already sorted by start, the live ones are ordered by end
+    using ActiveInterval = std::pair<std::size_t, RegisterIndex>;
+    std::priority_queue<ActiveInterval, std::vector<ActiveInterval>, std::greater<ActiveInterval>> active;
+    std::vector<RegisterIndex> free_registers;
+    std::vector<RegisterIndex> assigned(intervals_.size());
+    RegisterIndex register_count = 0;
+
+    for (std::size_t i = 0; i < intervals_.size(); ++i)
+    {
+        /// @note An instruction reads its operands before writing its destination,
+        /// an interval ending where this one starts already frees its register
+        while (!active.empty() && active.top().first <= intervals_[i].start)
+        {
+            free_registers.push_back(active.top().second);
+            active.pop();
+        }
+
+        if (free_registers.empty())
+        {
+            assigned[i] = register_count++;
+        }
+        else
+        {
+            assigned[i] = free_registers.back();
+            free_registers.pop_back();
+        }
+        active.emplace(intervals_[i].end, assigned[i]);
+    }
+    program_.temporary_count = register_count;
+
+    RegisterIndex first_temporary = static_cast<RegisterIndex>(program_.variables.size() + program_.constants.size());
+    auto rewrite = [&](RegisterIndex &operand) {
+        if ((operand & kVirtualTemporary) != 0 && operand != kNoRegister)
+        {
+            operand = first_temporary + assigned[operand & ~kVirtualTemporary];
+        }
+    };
+    for (RegisterInstruction &instruction : program_.code)
+    {
+        rewrite(instruction.destination);
+        rewrite(instruction.lhs);
+        rewrite(instruction.rhs);
+    }
+}
+
+// MARK: Virtual machine
+
+RegisterVm::RegisterVm(const RegisterProgram *program)
+    : program_{program}, registers_(program->get_register_count()) {}
+
+Value RegisterVm::get_value(SlotIndex slot) const noexcept
+{
+    return (program_->variables[slot].type == ValueType::REAL) ? Value::make_real(registers_[slot].real)
+                                                                : Value::make_integer(registers_[slot].integer);
+}
+
+#define VM_OPCODE RegisterOpcode
+#define VM_FETCH() (instruction = ip++)->opcode
+
+/// @brief Wrapping INTEGER arithmetic, computed on unsigned integers to stay well-defined
+static int wrap(std::uint32_t value) noexcept { return static_cast<int>(value); }
+
+void RegisterVm::run()
+{
+    std::size_t variable_count = program_->variables.size();
+    for (std::size_t slot = 0; slot < variable_count; slot++)
+    {
+        if (program_->variables[slot].type == ValueType::REAL)
+        {
+            registers_[slot].real = 0.0;
+        }
+        else
+        {
+            registers_[slot].integer = 0;
+        }
+    }
+    std::copy(program_->constants.begin(), program_->constants.end(), registers_.begin() + variable_count);
+
+    const RegisterInstruction *ip = program_->code.data();
+    const RegisterInstruction *instruction;
+    Cell *r = registers_.data();
+
+    VM_DISPATCH_TABLE(static_cast<std::size_t>(RegisterOpcode::HALT) + 1,
+                      &&MOVE, &&INTEGER_ADD, &&INTEGER_SUBTRACT, &&INTEGER_MULTIPLY, &&INTEGER_DIVIDE,
+                      &&INTEGER_NEGATE, &&REAL_ADD, &&REAL_SUBTRACT, &&REAL_MULTIPLY, &&REAL_DIVIDE, &&REAL_NEGATE,
+                      &&INTEGER_TO_REAL, &&HALT);
+
+    VM_DISPATCH_BEGIN
+    VM_CASE(MOVE)
+        r[instruction->destination] = r[instruction->lhs];
+        VM_NEXT;
+    VM_CASE(INTEGER_ADD)
+        r[instruction->destination].integer = wrap(static_cast<std::uint32_t>(r[instruction->lhs].integer) +
+                                                   static_cast<std::uint32_t>(r[instruction->rhs].integer));
+        VM_NEXT;
+    VM_CASE(INTEGER_SUBTRACT)
+        r[instruction->destination].integer = wrap(static_cast<std::uint32_t>(r[instruction->lhs].integer) -
+                                                   static_cast<std::uint32_t>(r[instruction->rhs].integer));
+        VM_NEXT;
+    VM_CASE(INTEGER_MULTIPLY)
+        r[instruction->destination].integer = wrap(static_cast<std::uint32_t>(r[instruction->lhs].integer) *
+                                                   static_cast<std::uint32_t>(r[instruction->rhs].integer));
+        VM_NEXT;
+    VM_CASE(INTEGER_DIVIDE)
+    {
+        int lhs = r[instruction->lhs].integer;
+        int rhs = r[instruction->rhs].integer;
+        if (rhs == 0)
+        {
+            throw ExecutionError(Operation::INTEGER_DIVIDE,
+                                 locate_instruction(program_->locations,
+                                                    static_cast<std::uint32_t>(instruction - program_->code.data())));
+        }
+        /// @note INT_MIN DIV -1 overflows, it wraps around like the other operators
+        r[instruction->destination].integer = (rhs == -1) ? wrap(0u - static_cast<std::uint32_t>(lhs)) : lhs / rhs;
+        VM_NEXT;
+    }
+    VM_CASE(INTEGER_NEGATE)
+        r[instruction->destination].integer = wrap(0u - static_cast<std::uint32_t>(r[instruction->lhs].integer));
+        VM_NEXT;
+    VM_CASE(REAL_ADD)
+        r[instruction->destination].real = r[instruction->lhs].real + r[instruction->rhs].real;
+        VM_NEXT;
+    VM_CASE(REAL_SUBTRACT)
+        r[instruction->destination].real = r[instruction->lhs].real - r[instruction->rhs].real;
+        VM_NEXT;
+    VM_CASE(REAL_MULTIPLY)
+        r[instruction->destination].real = r[instruction->lhs].real * r[instruction->rhs].real;
+        VM_NEXT;
+    VM_CASE(REAL_DIVIDE)
+        r[instruction->destination].real = r[instruction->lhs].real / r[instruction->rhs].real;
+        VM_NEXT;
+    VM_CASE(REAL_NEGATE)
+        r[instruction->destination].real = -r[instruction->lhs].real;
+        VM_NEXT;
+    VM_CASE(INTEGER_TO_REAL)
+        r[instruction->destination].real = r[instruction->lhs].integer;
+        VM_NEXT;
+    VM_CASE(HALT)
+        return;
+    VM_DEFAULT
+        __THROW_EXECUTING_ERROR
+    VM_DISPATCH_END
+}
+
+// MARK: Disassembler
+
+/// @brief Print the name of register *index* of *program*
+static void print_register(const RegisterProgram &program, RegisterIndex index, std::ostream &os)
+{
+    std::size_t variable_count = program.variables.size();
+    if (index < variable_count)
+    {
+        os << program.interner->get_name(program.variables[index].name).to_string();
+    }
+    else if (index < variable_count + program.constants.size())
+    {
+        os << 'k' << index - variable_count;
+    }
+    else
+    {
+        os << 't' << index - variable_count - program.constants.size();
+    }
+}
+
+void disassemble(const RegisterProgram &program, std::ostream &os)
+{
+    for (std::size_t offset = 0; offset < program.code.size(); ++offset)
+    {
+        const RegisterInstruction &instruction = program.code[offset];
+        os << std::setw(6) << std::setfill('0') << offset << std::setfill(' ') << "  ";
+        if (instruction.destination == kNoRegister)
+        {
+            os << map_register_opcode_to_string(instruction.opcode) << '\n';
+            continue;
+        }
+
+        os << std::left << std::setw(18) << map_register_opcode_to_string(instruction.opcode) << std::right;
+        print_register(program, instruction.destination, os);
+        for (RegisterIndex operand : {instruction.lhs, instruction.rhs})
+        {
+            if (operand != kNoRegister)
+            {
+                os << ", ";
+                print_register(program, operand, os);
+            }
+        }
+        os << '\n';
+    }
+}
@@ -0,0 +1,225 @@
+#ifndef REGISTER_VM_HPP
+#define REGISTER_VM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+#include "ast_node.hpp"
+#include "ast_visitor.hpp"
+#include "bytecode.hpp"
+#include "interner.hpp"
+#include "semantic_analyzer.hpp"
+#include "value.hpp"
+
+/// @brief Index of a register in the frame of a *RegisterVm*
+using RegisterIndex = std::uint32_t;
+
+/// @brief Marks an unused operand
+constexpr RegisterIndex kNoRegister = UINT32_MAX;
+
+/// @brief Instructions of a *RegisterProgram*, typed like *Opcode*
+enum class RegisterOpcode : unsigned char
+{
+    /// @brief destination = lhs, of any type
+    MOVE,
+
+    INTEGER_ADD,
+    INTEGER_SUBTRACT,
+    INTEGER_MULTIPLY,
+    INTEGER_DIVIDE,
+    /// @brief destination = -lhs
+    INTEGER_NEGATE,
+
+    REAL_ADD,
+    REAL_SUBTRACT,
+    REAL_MULTIPLY,
+    REAL_DIVIDE,
+    REAL_NEGATE,
+
+    /// @brief destination = lhs converted to REAL
+    INTEGER_TO_REAL,
+
+    /// @brief End of the program
+    HALT
+};
+
+const char *map_register_opcode_to_string(RegisterOpcode opcode) noexcept;
+
+/// @brief Three-address instruction: destination = lhs op rhs
+/// @note Operands are read before the destination is written, it may be one of them
+struct RegisterInstruction
+{
+    RegisterOpcode opcode;
+    RegisterIndex destination;
+    RegisterIndex lhs;
+    RegisterIndex rhs;
+};
+
+/// @brief Program compiled for a *RegisterVm*
+/// @note Layout of the register file of a frame:
+/// | variables (by slot) | constants | temporaries |
+/// Literals live in constant registers set when the frame is created, so they never
+/// need an instruction.
+struct RegisterProgram
+{
+    std::vector<RegisterInstruction> code;
+    /// @brief Value of the constant registers, the first one follows the variables
+    std::vector<Cell> constants;
+    /// @brief Declared variables, indexed by slot (and register)
+    std::vector<VariableSymbol> variables;
+    std::shared_ptr<Interner> interner;
+    /// @brief Number of registers holding expression temporaries
+    std::size_t temporary_count = 0;
+    /// @brief Location of every INTEGER_DIVIDE, by instruction index
+    std::vector<InstructionLocation> locations;
+
+    std::size_t get_register_count() const noexcept { return variables.size() + constants.size() + temporary_count; }
+};
+
+/// @brief Compiles an analyzed tree (see *SemanticAnalyzer*) to three-address code
+/// @note Every operator writes to a fresh virtual temporary, or straight to the variable
+/// when it is the last operation of an assignment. Variables and constants are read in place.
+/// A linear-scan allocator then maps the temporaries to as few registers as possible:
+/// their live intervals (definition to use) are scanned in order of definition, and the
+/// register of every interval ending at or before the current definition is reused.
+/// Common subexpressions are computed once (local value numbering): an instruction is keyed
+/// by its opcode and operands, a variable operand with the number of writes it had when read,
+/// so an assignment invalidates the expressions reading the previous value. A repeated
+/// expression reuses the register of the first one while that register still holds it.
+/// The expressions are remembered in a direct-mapped table of *kAvailableCapacity* entries,
+/// a new one evicts the one in its entry: no allocation, and old expressions are forgotten
+/// instead of keeping their temporaries live.
+class RegisterCompiler : public AstVisitor<RegisterCompiler>
+{
+public:
+    /// @note Throws if the analysis found errors
+    explicit RegisterCompiler(const SemanticAnalyzer &analyzer);
+
+    RegisterCompiler(const RegisterCompiler &) = delete;
+    RegisterCompiler &operator=(const RegisterCompiler &) = delete;
+
+    RegisterProgram compile();
+
+    // MARK: Handlers
+
+    void visit_block(BlockNode *node);
+    void visit_assignment_statement(AssignmentStatementNode *node);
+
+private:
+    /// @brief Instructions defining and using a virtual temporary
+    struct LiveInterval
+    {
+        std::size_t start;
+        std::size_t end;
+    };
+
+    /// @brief Opcode and operands of an instruction, with the version of the variable ones
+    struct Expression
+    {
+        RegisterOpcode opcode;
+        RegisterIndex lhs;
+        RegisterIndex rhs;
+        std::uint32_t lhs_version;
+        std::uint32_t rhs_version;
+
+        bool operator==(const Expression &other) const noexcept
+        {
+            return opcode == other.opcode && lhs == other.lhs && rhs == other.rhs &&
+                   lhs_version == other.lhs_version && rhs_version == other.rhs_version;
+        }
+    };
+
+    /// @brief Register holding the value of an *expression*, valid while a variable register
+    /// keeps its *version*, kNoRegister if the entry is empty
+    struct AvailableExpression
+    {
+        Expression expression;
+        RegisterIndex source;
+        std::uint32_t version;
+    };
+
+    /// @brief Entries of the table of available expressions, a power of two
+    static constexpr std::size_t kAvailableCapacity = 1024;
+
+    const SemanticAnalyzer &analyzer_;
+    RegisterProgram program_;
+    /// @brief Index in the constants of every literal, by value (the bits of a REAL)
+    std::unordered_map<int, std::uint32_t> integer_constants_;
+    std::unordered_map<std::uint64_t, std::uint32_t> real_constants_;
+    /// @brief Live interval of every virtual temporary, in order of definition
+    std::vector<LiveInterval> intervals_;
+    /// @brief Number of writes to every variable register
+    std::vector<std::uint32_t> versions_;
+    /// @brief Expressions already computed, by hash, see *compute()*
+    std::vector<AvailableExpression> available_;
+
+    ExpressionWalker walker_;
+    /// @brief Registers holding the operands compiled by *compile_expression()* and not used yet
+    std::vector<RegisterIndex> registers_;
+
+    /// @brief Compile the expression *node* into *destination*, or anywhere if kNoRegister
+    /// @note Compiled in post-order without recursion, expressions can nest 100k deep
+    /// @return Register holding the value of *node*
+    RegisterIndex compile_expression(AstNode *node, RegisterIndex destination);
+    /// @brief Compile *node* into *destination* (or anywhere if kNoRegister), over the registers
+    /// of its operands on top of *registers_* (popped)
+    /// @return Register holding the value of *node*, promoted if it is
+    RegisterIndex compile_node(AstNode *node, RegisterIndex destination);
+    RegisterIndex pop_register() noexcept;
+    /// @brief *destination* if it is a register, or a new virtual temporary
+    RegisterIndex target(RegisterIndex destination);
+    /// @brief Record that the next instruction reads *source*
+    RegisterIndex use(RegisterIndex source);
+    /// @brief Copy *source* into *destination* if needed
+    RegisterIndex move(RegisterIndex destination, RegisterIndex source);
+    /// @brief Compute *opcode* of *lhs* and *rhs* into *destination* (or anywhere if kNoRegister),
+    /// unless a register still holds the same expression. *node* locates an INTEGER_DIVIDE.
+    /// @return Register holding the result
+    RegisterIndex compute(RegisterOpcode opcode, RegisterIndex destination, RegisterIndex lhs, RegisterIndex rhs,
+                          const AstNode *node);
+    /// @brief Entry of *expression* in a table of *capacity* entries (a power of two)
+    static std::size_t hash_expression(const Expression &expression, std::size_t capacity) noexcept;
+    /// @brief Number of writes to *source* so far, 0 for constants and temporaries (written once)
+    std::uint32_t get_version(RegisterIndex source) const noexcept;
+    RegisterIndex integer_constant(int value);
+    RegisterIndex real_constant(double value);
+    /// @note Bumps the version of a variable *destination*
+    void emit(RegisterOpcode opcode, RegisterIndex destination, RegisterIndex lhs, RegisterIndex rhs = kNoRegister);
+    /// @brief Give every virtual temporary a register, and rewrite the operands
+    void allocate_registers();
+};
+
+/// @brief Virtual machine running a *RegisterProgram* over a register file
+/// @note Same semantics as the *Interpreter*
+class RegisterVm
+{
+public:
+    /// @note *program* is not owned and must outlive the machine
+    explicit RegisterVm(const RegisterProgram *program);
+
+    RegisterVm(const RegisterVm &) = delete;
+    RegisterVm &operator=(const RegisterVm &) = delete;
+
+    /// @brief Execute the program, from fresh variables
+    /// @note Throws an *ExecutionError* on a division by zero (DIV)
+    void run();
+
+    std::size_t get_variable_count() const noexcept { return program_->variables.size(); }
+    SymbolId get_symbol(SlotIndex slot) const noexcept { return program_->variables[slot].name; }
+    /// @brief Value of the variable in *slot* (after *run()*, its final value)
+    Value get_value(SlotIndex slot) const noexcept;
+    const std::shared_ptr<Interner> &get_interner() const noexcept { return program_->interner; }
+
+private:
+    const RegisterProgram *program_;
+    std::vector<Cell> registers_;
+};
+
+/// @brief Print the instructions of *program*, one per line, naming variables,
+/// constants (k0, k1, ...) and temporaries (t0, t1, ...)
+void disassemble(const RegisterProgram &program, std::ostream &os);
+
+#endif
@@ -0,0 +1,186 @@
+#include "semantic_analyzer.hpp"
+#include "token.hpp"
+
+const char *map_value_type_to_string(ValueType type) noexcept
+{
+    switch (type)
+    {
+    case ValueType::INTEGER:
+        return "INTEGER";
+    case ValueType::REAL:
+        return "REAL";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+SemanticAnalyzer::SemanticAnalyzer(AbstractSyntaxTree *ast) : ast_{ast} {}
+
+bool SemanticAnalyzer::analyze()
+{
+    /// @note Symbols are dense, the symbol table is a plain array
+    slots_.assign(ast_->get_interner()->size(), kNoSlot);
+    visit(ast_->get_root());
+    return !has_errors();
+}
+
+void SemanticAnalyzer::error(const AstNode *node, const std::string &message)
+{
+    diagnostics_.emplace_back(node->get_offset(), message, DiagnosticSeverity::ERROR);
+}
+
+std::string SemanticAnalyzer::quote(SymbolId symbol) const
+{
+    return "'" + ast_->get_interner()->get_name(symbol).to_string() + "'";
+}
+
+void SemanticAnalyzer::promote(AstNode *node, ValueType type) noexcept
+{
+    node->set_promoted(type == ValueType::INTEGER);
+}
+
+ValueType SemanticAnalyzer::resolve(VariableNode *node)
+{
+    SlotIndex slot = slots_[node->get_symbol()];
+    if (slot == kNoSlot)
+    {
+        error(node, "Undeclared variable " + quote(node->get_symbol()));
+        return ValueType::INTEGER;
+    }
+    node->set_slot(slot);
+    return variables_[slot].type;
+}
+
+ValueType SemanticAnalyzer::visit_block(BlockNode *node)
+{
+    for (VarDeclNode *declaration : node->get_declaration_nodes())
+    {
+        VariableNode *variable = declaration->get_var_node();
+        SymbolId symbol = variable->get_symbol();
+        if (slots_[symbol] != kNoSlot)
+        {
+            error(variable, "Duplicate variable " + quote(symbol));
+            continue;
+        }
+
+        ValueType type =
+            (declaration->get_type_node()->get_token()->get_type() == TokenType::REAL) ? ValueType::REAL
+                                                                                        : ValueType::INTEGER;
+        slots_[symbol] = static_cast<SlotIndex>(variables_.size());
+        variable->set_slot(slots_[symbol]);
+        variables_.push_back(VariableSymbol{symbol, type});
+    }
+
+    visit(node->get_compound_statement_node());
+    return ValueType::INTEGER;
+}
+
+ValueType SemanticAnalyzer::visit_assignment_statement(AssignmentStatementNode *node)
+{
+    ValueType target = resolve(node->get_lhs());
+    ValueType value = analyze_expression(node->get_rhs());
+
+    if (target == ValueType::REAL)
+    {
+        promote(node->get_rhs(), value);
+        node->set_operation(Operation::REAL_STORE);
+    }
+    else
+    {
+        if (value == ValueType::REAL)
+        {
+            error(node, "Cannot assign a REAL value to INTEGER variable " + quote(node->get_lhs()->get_symbol()));
+        }
+        node->set_operation(Operation::INTEGER_STORE);
+    }
+    return target;
+}
+
+ValueType SemanticAnalyzer::analyze_expression(AstNode *node)
+{
+    types_.clear();
+    walker_.walk(node, [this](AstNode *node) {
+        switch (node->get_type())
+        {
+        case AstNodeType::BINARY_OPERATOR:
+        {
+            ValueType rhs = types_.back();
+            types_.pop_back();
+            types_.back() = type_binary_operator(static_cast<BinaryOperatorNode *>(node), types_.back(), rhs);
+            break;
+        }
+        case AstNodeType::UNARY_OPERATOR:
+            types_.back() = type_unary_operator(static_cast<UnaryOperatorNode *>(node), types_.back());
+            break;
+        default:
+            /// @note A leaf, visiting it does not recurse
+            types_.push_back(visit(node));
+            break;
+        }
+    });
+    return types_.back();
+}
+
+ValueType SemanticAnalyzer::type_binary_operator(BinaryOperatorNode *node, ValueType lhs, ValueType rhs)
+{
+    TokenType op = node->get_token()->get_type();
+
+    if (op == TokenType::INTEGER_DIV)
+    {
+        if (lhs == ValueType::REAL || rhs == ValueType::REAL)
+        {
+            error(node, "DIV expects INTEGER operands");
+        }
+        node->set_operation(Operation::INTEGER_DIVIDE);
+        return ValueType::INTEGER;
+    }
+
+    if (op != TokenType::FLOAT_DIV && lhs == ValueType::INTEGER && rhs == ValueType::INTEGER)
+    {
+        node->set_operation(op == TokenType::PLUS    ? Operation::INTEGER_ADD
+                            : op == TokenType::MINUS ? Operation::INTEGER_SUBTRACT
+                                                     : Operation::INTEGER_MULTIPLY);
+        return ValueType::INTEGER;
+    }
+
+    promote(node->get_lhs(), lhs);
+    promote(node->get_rhs(), rhs);
+    node->set_operation(op == TokenType::PLUS    ? Operation::REAL_ADD
+                        : op == TokenType::MINUS ? Operation::REAL_SUBTRACT
+                        : op == TokenType::MUL   ? Operation::REAL_MULTIPLY
+                                                 : Operation::REAL_DIVIDE);
+    return ValueType::REAL;
+}
+
+ValueType SemanticAnalyzer::type_unary_operator(UnaryOperatorNode *node, ValueType operand)
+{
+    bool is_negation = node->get_token()->get_type() == TokenType::MINUS;
+    if (operand == ValueType::INTEGER)
+    {
+        node->set_operation(is_negation ? Operation::INTEGER_NEGATE : Operation::INTEGER_IDENTITY);
+    }
+    else
+    {
+        node->set_operation(is_negation ? Operation::REAL_NEGATE : Operation::REAL_IDENTITY);
+    }
+    return operand;
+}
+
+ValueType SemanticAnalyzer::visit_variable(VariableNode *node)
+{
+    ValueType type = resolve(node);
+    node->set_operation((type == ValueType::REAL) ? Operation::REAL_LOAD : Operation::INTEGER_LOAD);
+    return type;
+}
+
+ValueType SemanticAnalyzer::visit_int_num(IntNumNode *node)
+{
+    node->set_operation(Operation::INTEGER_CONSTANT);
+    return ValueType::INTEGER;
+}
+
+ValueType SemanticAnalyzer::visit_real_num(RealNumNode *node)
+{
+    node->set_operation(Operation::REAL_CONSTANT);
+    return ValueType::REAL;
+}
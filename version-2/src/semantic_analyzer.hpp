@@ -0,0 +1,103 @@
+#ifndef SEMANTIC_ANALYZER_HPP
+#define SEMANTIC_ANALYZER_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ast.hpp"
+#include "ast_node.hpp"
+#include "ast_visitor.hpp"
+#include "diagnostic.hpp"
+#include "interner.hpp"
+
+#define __THROW_ANALYZING_ERROR(analyzer) \
+    throw std::runtime_error("Error analyzing program: " + (analyzer).get_diagnostics().front().get_message());
+
+/// @brief Static type of a variable or an expression
+enum class ValueType : unsigned char
+{
+    INTEGER,
+    REAL
+};
+
+const char *map_value_type_to_string(ValueType type) noexcept;
+
+/// @brief Variable declared in the block of a program
+struct VariableSymbol
+{
+    SymbolId name;
+    ValueType type;
+};
+
+/// @brief Checks the variables and the types of a program and annotates its tree for evaluation
+/// @note The symbol table gives every declared variable a slot, in declaration order.
+/// Every *VariableNode* gets the slot of its variable, every expression node the typed
+/// *Operation* computing it, every assignment an INTEGER_STORE or REAL_STORE, and every
+/// INTEGER expression used where a REAL is expected is marked promoted.
+///
+/// Typing rules: +, - and * are INTEGER over two INTEGER operands and REAL otherwise,
+/// / is always REAL, DIV takes INTEGER operands only, a REAL cannot be assigned to an
+/// INTEGER variable.
+///
+/// Errors are reported as diagnostics located at the offending node, analysis goes on
+/// (an undeclared variable is taken as INTEGER).
+///
+/// Expressions are analyzed without recursion (see *ExpressionWalker*), however deep they nest.
+/// @warning The annotations are written into the nodes, a tree must not be analyzed
+/// by two threads at once
+class SemanticAnalyzer : public AstVisitor<SemanticAnalyzer, ValueType>
+{
+public:
+    explicit SemanticAnalyzer(AbstractSyntaxTree *ast);
+
+    SemanticAnalyzer(const SemanticAnalyzer &) = delete;
+    SemanticAnalyzer &operator=(const SemanticAnalyzer &) = delete;
+
+    /// @brief Analyze the whole tree, once
+    /// @return false if an error was found
+    bool analyze();
+
+    AbstractSyntaxTree *get_ast() const noexcept { return ast_; }
+    /// @brief Declared variables, indexed by slot
+    const std::vector<VariableSymbol> &get_variables() const noexcept { return variables_; }
+    const std::vector<Diagnostic> &get_diagnostics() const noexcept { return diagnostics_; }
+    bool has_errors() const noexcept { return !diagnostics_.empty(); }
+
+    // MARK: Handlers
+
+    ValueType visit_block(BlockNode *node);
+    ValueType visit_assignment_statement(AssignmentStatementNode *node);
+    ValueType visit_binary_operator(BinaryOperatorNode *node) { return analyze_expression(node); }
+    ValueType visit_unary_operator(UnaryOperatorNode *node) { return analyze_expression(node); }
+    ValueType visit_variable(VariableNode *node);
+    ValueType visit_int_num(IntNumNode *node);
+    ValueType visit_real_num(RealNumNode *node);
+
+private:
+    AbstractSyntaxTree *ast_;
+    std::vector<VariableSymbol> variables_;
+    /// @brief Slot of every symbol, *kNoSlot* if it is not a declared variable
+    std::vector<SlotIndex> slots_;
+    std::vector<Diagnostic> diagnostics_;
+    ExpressionWalker walker_;
+    /// @brief Types of the operands analyzed by *analyze_expression()* and not used yet
+    std::vector<ValueType> types_;
+
+    /// @brief Analyze the expression *node* in post-order
+    /// @return Its type
+    ValueType analyze_expression(AstNode *node);
+    /// @brief Type *node* over the types of its operands, already analyzed
+    ValueType type_binary_operator(BinaryOperatorNode *node, ValueType lhs, ValueType rhs);
+    ValueType type_unary_operator(UnaryOperatorNode *node, ValueType operand);
+    /// @brief Give *node* the slot of its variable
+    /// @return The type of the variable, INTEGER if it is not declared (reported)
+    ValueType resolve(VariableNode *node);
+    /// @brief Mark *node* promoted if its type is INTEGER
+    static void promote(AstNode *node, ValueType type) noexcept;
+    void error(const AstNode *node, const std::string &message);
+    /// @brief Quoted name of *symbol*, for messages
+    std::string quote(SymbolId symbol) const;
+};
+
+#endif
@@ -0,0 +1,85 @@
+#include "source.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        __THROW_MAPPING_FILE_ERROR
+    }
+
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0)
+    {
+        ::close(fd);
+        __THROW_MAPPING_FILE_ERROR
+    }
+
+    length_ = static_cast<std::size_t>(file_stat.st_size);
+    /// @note mmap() rejects zero-length mappings, an empty file is simply an empty view
+    if (length_ > 0)
+    {
+        void *mapping = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            ::close(fd);
+            __THROW_MAPPING_FILE_ERROR
+        }
+        /// @note The source is read once from front to back
+        ::madvise(mapping, length_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char *>(mapping);
+    }
+
+    /// @note The mapping stays valid after the descriptor is closed
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr)
+    {
+        ::munmap(const_cast<char *>(data_), length_);
+    }
+}
+
+SourceView MappedFile::get_view() const noexcept { return SourceView(data_, length_); }
+
+SourceStream::~SourceStream() {}
+
+IStreamSource::IStreamSource(std::istream &input) : input_{input} {}
+
+std::size_t IStreamSource::read(char *buffer, std::size_t capacity)
+{
+    input_.read(buffer, static_cast<std::streamsize>(capacity));
+    if (input_.bad())
+    {
+        __THROW_READING_SOURCE_ERROR
+    }
+    return static_cast<std::size_t>(input_.gcount());
+}
+
+FileDescriptorSource::FileDescriptorSource(int fd) : fd_{fd} {}
+
+std::size_t FileDescriptorSource::read(char *buffer, std::size_t capacity)
+{
+    for (;;)
+    {
+        ssize_t count = ::read(fd_, buffer, capacity);
+        if (count >= 0)
+        {
+            return static_cast<std::size_t>(count);
+        }
+        if (errno != EINTR)
+        {
+            __THROW_READING_SOURCE_ERROR
+        }
+    }
+}
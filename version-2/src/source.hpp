@@ -0,0 +1,94 @@
+#ifndef SOURCE_HPP
+#define SOURCE_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+#define __THROW_MAPPING_FILE_ERROR \
+    throw std::runtime_error("Error mapping source file");
+
+#define __THROW_READING_SOURCE_ERROR \
+    throw std::runtime_error("Error reading source");
+
+/// @brief Non-owning view over a range of characters.
+/// @note Stand-in for std::string_view, which is not available in C++ 14.
+/// The owner of the characters must keep them alive while the view is in use.
+class SourceView
+{
+public:
+    SourceView() noexcept : data_{nullptr}, length_{0} {}
+    SourceView(const char *data, std::size_t length) noexcept : data_{data}, length_{length} {}
+
+    const char *data() const noexcept { return data_; }
+    std::size_t length() const noexcept { return length_; }
+    char operator[](std::size_t index) const noexcept { return data_[index]; }
+
+    /// @brief View over *length* characters starting at *offset*
+    SourceView slice(std::size_t offset, std::size_t length) const noexcept { return SourceView(data_ + offset, length); }
+    /// @brief Materialize the viewed characters
+    std::string to_string() const { return std::string(data_, length_); }
+
+private:
+    const char *data_;
+    std::size_t length_;
+};
+
+/// @brief Read-only memory mapped source file
+/// @note The mapping is released when the object is destroyed, every *SourceView*
+/// obtained from *get_view()* is dangling afterwards.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /// @brief View over the whole file content
+    SourceView get_view() const noexcept;
+
+private:
+    const char *data_ = nullptr;
+    std::size_t length_ = 0;
+};
+
+/// @brief Source code delivered piece by piece (generated on the fly, piped, ...)
+class SourceStream
+{
+public:
+    virtual ~SourceStream();
+
+    /// @brief Read at most *capacity* characters into *buffer*
+    /// @return Number of characters read, 0 once the end of the source is reached
+    virtual std::size_t read(char *buffer, std::size_t capacity) = 0;
+};
+
+/// @brief Source code read from a std::istream
+class IStreamSource : public SourceStream
+{
+public:
+    /// @note *input* is not owned and must outlive this object
+    explicit IStreamSource(std::istream &input);
+
+    std::size_t read(char *buffer, std::size_t capacity) override;
+
+private:
+    std::istream &input_;
+};
+
+/// @brief Source code read from a file descriptor (file, pipe, socket, ...)
+class FileDescriptorSource : public SourceStream
+{
+public:
+    /// @note *fd* is not owned, it is not closed by this object
+    explicit FileDescriptorSource(int fd);
+
+    std::size_t read(char *buffer, std::size_t capacity) override;
+
+private:
+    int fd_;
+};
+
+#endif
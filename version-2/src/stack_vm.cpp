@@ -0,0 +1,126 @@
+#include "stack_vm.hpp"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "dispatch.hpp"
+
+StackVm::StackVm(const BytecodeProgram *program)
+    : program_{program}, stack_(program->max_stack_depth + 1), variables_(program->variables.size()) {}
+
+Value StackVm::get_value(SlotIndex slot) const noexcept
+{
+    return (program_->variables[slot].type == ValueType::REAL) ? Value::make_real(variables_[slot].real)
+                                                                : Value::make_integer(variables_[slot].integer);
+}
+
+#define VM_OPCODE Opcode
+#define VM_FETCH() static_cast<Opcode>(*ip++)
+
+/// @brief Wrapping INTEGER arithmetic, computed on unsigned integers to stay well-defined
+static int wrap(std::uint32_t value) noexcept { return static_cast<int>(value); }
+
+void StackVm::run()
+{
+    for (std::size_t slot = 0; slot < variables_.size(); slot++)
+    {
+        if (program_->variables[slot].type == ValueType::REAL)
+        {
+            variables_[slot].real = 0.0;
+        }
+        else
+        {
+            variables_[slot].integer = 0;
+        }
+    }
+
+    const std::uint8_t *ip = program_->code.data();
+    const double *reals = program_->reals.data();
+    Cell *variables = variables_.data();
+    /// @note Points to the top entry, the first push goes to stack_[1]
+    Cell *sp = stack_.data();
+    std::uint32_t operand;
+
+    VM_DISPATCH_TABLE(static_cast<std::size_t>(Opcode::HALT) + 1,
+                      &&INTEGER_PUSH, &&REAL_PUSH, &&INTEGER_LOAD, &&REAL_LOAD, &&INTEGER_STORE, &&REAL_STORE,
+                      &&INTEGER_ADD, &&INTEGER_SUBTRACT, &&INTEGER_MULTIPLY, &&INTEGER_DIVIDE, &&INTEGER_NEGATE,
+                      &&REAL_ADD, &&REAL_SUBTRACT, &&REAL_MULTIPLY, &&REAL_DIVIDE, &&REAL_NEGATE,
+                      &&INTEGER_TO_REAL, &&HALT);
+
+    VM_DISPATCH_BEGIN
+    VM_CASE(INTEGER_PUSH)
+        std::memcpy(&operand, ip, sizeof(operand));
+        ip += sizeof(operand);
+        (++sp)->integer = static_cast<int>(operand);
+        VM_NEXT;
+    VM_CASE(REAL_PUSH)
+        std::memcpy(&operand, ip, sizeof(operand));
+        ip += sizeof(operand);
+        (++sp)->real = reals[operand];
+        VM_NEXT;
+    VM_CASE(INTEGER_LOAD)
+    VM_CASE(REAL_LOAD)
+        std::memcpy(&operand, ip, sizeof(operand));
+        ip += sizeof(operand);
+        *++sp = variables[operand];
+        VM_NEXT;
+    VM_CASE(INTEGER_STORE)
+    VM_CASE(REAL_STORE)
+        std::memcpy(&operand, ip, sizeof(operand));
+        ip += sizeof(operand);
+        variables[operand] = *sp--;
+        VM_NEXT;
+    VM_CASE(INTEGER_ADD)
+        --sp;
+        sp->integer = wrap(static_cast<std::uint32_t>(sp->integer) + static_cast<std::uint32_t>(sp[1].integer));
+        VM_NEXT;
+    VM_CASE(INTEGER_SUBTRACT)
+        --sp;
+        sp->integer = wrap(static_cast<std::uint32_t>(sp->integer) - static_cast<std::uint32_t>(sp[1].integer));
+        VM_NEXT;
+    VM_CASE(INTEGER_MULTIPLY)
+        --sp;
+        sp->integer = wrap(static_cast<std::uint32_t>(sp->integer) * static_cast<std::uint32_t>(sp[1].integer));
+        VM_NEXT;
+    VM_CASE(INTEGER_DIVIDE)
+        --sp;
+        if (sp[1].integer == 0)
+        {
+            throw ExecutionError(Operation::INTEGER_DIVIDE,
+                                 locate_instruction(program_->locations,
+                                                    static_cast<std::uint32_t>(ip - 1 - program_->code.data())));
+        }
+        /// @note INT_MIN DIV -1 overflows, it wraps around like the other operators
+        sp->integer = (sp[1].integer == -1) ? wrap(0u - static_cast<std::uint32_t>(sp->integer))
+                                            : sp->integer / sp[1].integer;
+        VM_NEXT;
+    VM_CASE(INTEGER_NEGATE)
+        sp->integer = wrap(0u - static_cast<std::uint32_t>(sp->integer));
+        VM_NEXT;
+    VM_CASE(REAL_ADD)
+        --sp;
+        sp->real += sp[1].real;
+        VM_NEXT;
+    VM_CASE(REAL_SUBTRACT)
+        --sp;
+        sp->real -= sp[1].real;
+        VM_NEXT;
+    VM_CASE(REAL_MULTIPLY)
+        --sp;
+        sp->real *= sp[1].real;
+        VM_NEXT;
+    VM_CASE(REAL_DIVIDE)
+        --sp;
+        sp->real /= sp[1].real;
+        VM_NEXT;
+    VM_CASE(REAL_NEGATE)
+        sp->real = -sp->real;
+        VM_NEXT;
+    VM_CASE(INTEGER_TO_REAL)
+        sp->real = sp->integer;
+        VM_NEXT;
+    VM_CASE(HALT)
+        return;
+    VM_DEFAULT
+        __THROW_EXECUTING_ERROR
+    VM_DISPATCH_END
+}
@@ -0,0 +1,39 @@
+#ifndef STACK_VM_HPP
+#define STACK_VM_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "bytecode.hpp"
+#include "interner.hpp"
+#include "value.hpp"
+
+/// @brief Virtual machine running a *BytecodeProgram* over an operand stack
+/// @note The stack is sized once from *BytecodeProgram::max_stack_depth*,
+/// instructions never check for overflow. Same semantics as the *Interpreter*.
+class StackVm
+{
+public:
+    /// @note *program* is not owned and must outlive the machine
+    explicit StackVm(const BytecodeProgram *program);
+
+    StackVm(const StackVm &) = delete;
+    StackVm &operator=(const StackVm &) = delete;
+
+    /// @brief Execute the program, from fresh variables
+    /// @note Throws an *ExecutionError* on a division by zero (DIV)
+    void run();
+
+    std::size_t get_variable_count() const noexcept { return variables_.size(); }
+    SymbolId get_symbol(SlotIndex slot) const noexcept { return program_->variables[slot].name; }
+    /// @brief Value of the variable in *slot* (after *run()*, its final value)
+    Value get_value(SlotIndex slot) const noexcept;
+    const std::shared_ptr<Interner> &get_interner() const noexcept { return program_->interner; }
+
+private:
+    const BytecodeProgram *program_;
+    std::vector<Cell> stack_;
+    std::vector<Cell> variables_;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/// @brief Fixed set of worker threads running submitted tasks in FIFO order
+/// @note Workers are joined by the destructor once every pending task has run.
+class ThreadPool
+{
+public:
+    /// @param thread_count Number of workers, 0 means one per hardware thread
+    explicit ThreadPool(std::size_t thread_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    std::size_t get_thread_count() const noexcept { return workers_.size(); }
+
+    /// @brief Queue *task* for execution on a worker
+    /// @return Future becoming ready when *task* completes, rethrowing what it threw
+    std::future<void> submit(std::function<void()> task);
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::packaged_task<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable wake_up_;
+    bool stopping_ = false;
+
+    void work();
+};
+
+#endif
@@ -25,16 +25,15 @@ Token &Token::operator=(const Token &rhs)
     return *this;
 }
 
-IdToken::IdToken(const std::string &value) : Token(TokenType::ID), value_(value) {}
-IdToken::IdToken(std::string &&value) : Token(TokenType::ID), value_(std::move(value)) {}
+IdToken::IdToken(SymbolId symbol) : Token(TokenType::ID), symbol_(symbol) {}
 
-const std::string &IdToken::get_value() const noexcept
+SymbolId IdToken::get_symbol() const noexcept
 {
-    return value_;
+    return symbol_;
 }
 std::ostream &operator<<(std::ostream &out_stream, const IdToken &token)
 {
-    return out_stream << "Token: " << map_token_type_to_string(token.get_type()) << "(" << token.get_value() << ")";
+    return out_stream << "Token: " << map_token_type_to_string(token.get_type()) << "(#" << token.get_symbol() << ")";
 }
 
 IntNumToken::IntNumToken(int value) : Token(TokenType::INTEGER_NUMBER), value_{value} {}
@@ -44,8 +43,8 @@ std::ostream &operator<<(std::ostream &out_stream, const IntNumToken &token)
     return out_stream << "Token: " << map_token_type_to_string(token.get_type()) << "(" << token.get_value() << ")";
 }
 
-RealNumToken::RealNumToken(float value) : Token(TokenType::REAL_NUMBER), value_{value} {}
-float RealNumToken::get_value() const noexcept { return value_; }
+RealNumToken::RealNumToken(double value) : Token(TokenType::REAL_NUMBER), value_{value} {}
+double RealNumToken::get_value() const noexcept { return value_; }
 std::ostream &operator<<(std::ostream &out_stream, const RealNumToken &token)
 {
     return out_stream << "Token: " << map_token_type_to_string(token.get_type()) << "(" << token.get_value() << ")";
@@ -4,10 +4,14 @@
 #include <ostream>
 #include <string>
 #include <string_view>
+#include "interner.hpp"
 
 /// @brief Present None character
 constexpr char kNull = '\0';
 constexpr char kWhitespace = ' ';
+constexpr char kTab = '\t';
+constexpr char kNewLine = '\n';
+constexpr char kCarriageReturn = '\r';
 constexpr char kPlus = '+';
 constexpr char kMinus = '-';
 constexpr char kMul = '*';
@@ -22,6 +26,12 @@ constexpr char kRightCurlyBrace = '}';
 constexpr char kLParen = '(';
 constexpr char kRParen = ')';
 
+/// @brief Whether *c* separates tokens (blank, tab or line break)
+constexpr bool is_whitespace(char c) noexcept
+{
+    return c == kWhitespace || c == kTab || c == kNewLine || c == kCarriageReturn;
+}
+
 /// @brief Token types
 enum class TokenType : unsigned char
 {
@@ -84,15 +94,15 @@ protected:
 class IdToken : public Token
 {
 public:
-    explicit IdToken(const std::string &value);
-    explicit IdToken(std::string &&value);
+    explicit IdToken(SymbolId symbol);
 
-    const std::string &get_value() const noexcept;
+    /// @brief Interned name of the identifier, see *Interner::get_name()*
+    SymbolId get_symbol() const noexcept;
 
     friend std::ostream &operator<<(std::ostream &os, const IdToken &token);
 
 protected:
-    std::string value_;
+    SymbolId symbol_;
 };
 
 class IntNumToken : public Token
@@ -111,14 +121,14 @@ protected:
 class RealNumToken : public Token
 {
 public:
-    explicit RealNumToken(float value);
+    explicit RealNumToken(double value);
 
-    float get_value() const noexcept;
+    double get_value() const noexcept;
 
     friend std::ostream &operator<<(std::ostream &os, const RealNumToken &token);
 
 protected:
-    float value_;
+    double value_;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "token_buffer.hpp"
+#include <algorithm>
+#include "token.hpp"
+
+TokenBuffer::TokenBuffer(SourceView source, std::shared_ptr<Interner> interner)
+    : source_{source}, interner_{std::move(interner)} {}
+
+void TokenBuffer::reserve(std::size_t capacity) { tokens_.reserve(capacity); }
+void TokenBuffer::push_back(const BufferedToken &token) { tokens_.push_back(token); }
+void TokenBuffer::resize(std::size_t size) { tokens_.resize(size); }
+
+void TokenBuffer::splice(std::size_t first, std::size_t last, const std::vector<BufferedToken> &tokens)
+{
+    std::size_t common = std::min(last - first, tokens.size());
+    std::copy(tokens.begin(), tokens.begin() + common, tokens_.begin() + first);
+    if (common < tokens.size())
+    {
+        tokens_.insert(tokens_.begin() + first + common, tokens.begin() + common, tokens.end());
+    }
+    else
+    {
+        tokens_.erase(tokens_.begin() + first + common, tokens_.begin() + last);
+    }
+}
+
+SourceView TokenBuffer::get_lexeme(const BufferedToken &token) const noexcept
+{
+    return source_.slice(token.get_offset(), token.get_length());
+}
@@ -0,0 +1,115 @@
+#ifndef TOKEN_BUFFER_HPP
+#define TOKEN_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "interner.hpp"
+#include "source.hpp"
+#include "token.hpp"
+
+/// @brief Fixed-size tagged token (type + payload + source offset).
+/// @note Unlike *Token* and its subclasses, a *BufferedToken* is a plain value:
+/// it is never heap-allocated on its own and can be stored contiguously.
+/// Identifier lexemes are not copied, the token only records where the
+/// lexeme lives in the source (offset + length) and, when the lexer interns
+/// identifiers, its *SymbolId*.
+/// @note Offsets are 32-bit, sources are limited to 4 GiB.
+class BufferedToken
+{
+public:
+    BufferedToken() noexcept : type_{TokenType::END_OF_FILE}, offset_{0}, id_{0, kInvalidSymbol} {}
+    BufferedToken(TokenType type, std::uint32_t offset) noexcept : type_{type}, offset_{offset}, id_{0, kInvalidSymbol} {}
+
+    static BufferedToken make_id(std::uint32_t offset, std::uint32_t length, SymbolId symbol = kInvalidSymbol) noexcept
+    {
+        BufferedToken token{TokenType::ID, offset};
+        token.id_.length = length;
+        token.id_.symbol = symbol;
+        return token;
+    }
+    static BufferedToken make_int_num(std::uint32_t offset, int value) noexcept
+    {
+        BufferedToken token{TokenType::INTEGER_NUMBER, offset};
+        token.int_value_ = value;
+        return token;
+    }
+    static BufferedToken make_real_num(std::uint32_t offset, double value) noexcept
+    {
+        BufferedToken token{TokenType::REAL_NUMBER, offset};
+        token.real_value_ = value;
+        return token;
+    }
+
+    /// @brief Move the token, e.g. when text is inserted or removed before it
+    void set_offset(std::uint32_t offset) noexcept { offset_ = offset; }
+
+    /// @brief Retrieve the type of the token
+    TokenType get_type() const noexcept { return type_; }
+    /// @brief Offset of the first character of the token in the source code
+    std::uint32_t get_offset() const noexcept { return offset_; }
+    /// @brief Length of the lexeme, only meaningful for *TokenType::ID*
+    std::uint32_t get_length() const noexcept { return id_.length; }
+    /// @brief Interned identifier, only meaningful for *TokenType::ID*
+    /// @note *kInvalidSymbol* when the producing lexer had no interner
+    SymbolId get_symbol() const noexcept { return id_.symbol; }
+    /// @brief Value of an *TokenType::INTEGER_NUMBER* token
+    int get_int_value() const noexcept { return int_value_; }
+    /// @brief Value of an *TokenType::REAL_NUMBER* token
+    double get_real_value() const noexcept { return real_value_; }
+
+private:
+    struct IdPayload
+    {
+        std::uint32_t length;
+        SymbolId symbol;
+    };
+
+    TokenType type_;
+    std::uint32_t offset_;
+    union
+    {
+        IdPayload id_;
+        int int_value_;
+        double real_value_;
+    };
+};
+
+static_assert(sizeof(BufferedToken) == 16, "BufferedToken must stay compact");
+
+/// @brief Flat, contiguous list of tokens produced by *Lexer::tokenize()*.
+/// @warning The buffer does not own the source code, identifier lexemes are
+/// slices of the code the *Lexer* was tokenizing, so that code must outlive the buffer.
+class TokenBuffer
+{
+public:
+    TokenBuffer(SourceView source, std::shared_ptr<Interner> interner);
+
+    void reserve(std::size_t capacity);
+    void push_back(const BufferedToken &token);
+    /// @brief Grow or shrink to *size* tokens, new tokens are *TokenType::END_OF_FILE*
+    /// placeholders meant to be overwritten (e.g. by several threads, each filling its own range)
+    void resize(std::size_t size);
+    /// @brief Replace the tokens [first, last) with *tokens*
+    void splice(std::size_t first, std::size_t last, const std::vector<BufferedToken> &tokens);
+
+    std::size_t size() const noexcept { return tokens_.size(); }
+    const BufferedToken &operator[](std::size_t index) const noexcept { return tokens_[index]; }
+    BufferedToken &operator[](std::size_t index) noexcept { return tokens_[index]; }
+
+    /// @brief Point lexemes at *source*, e.g. after the source was edited and reallocated
+    void set_source(SourceView source) noexcept { source_ = source; }
+    /// @brief Slice of the source holding the lexeme of an identifier token
+    SourceView get_lexeme(const BufferedToken &token) const noexcept;
+    /// @brief Interner the identifier symbols of this buffer belong to, may be nullptr
+    const std::shared_ptr<Interner> &get_interner() const noexcept { return interner_; }
+
+private:
+    SourceView source_;
+    std::shared_ptr<Interner> interner_;
+    std::vector<BufferedToken> tokens_;
+};
+
+#endif
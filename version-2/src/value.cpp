@@ -0,0 +1,32 @@
+#include "value.hpp"
+#include <ostream>
+#include <string>
+
+Value Value::make_integer(int value) noexcept
+{
+    Value result;
+    result.type_ = ValueType::INTEGER;
+    result.integer_ = value;
+    return result;
+}
+
+Value Value::make_real(double value) noexcept
+{
+    Value result;
+    result.type_ = ValueType::REAL;
+    result.real_ = value;
+    return result;
+}
+
+ExecutionError::ExecutionError(Operation operation, std::uint32_t offset)
+    : std::runtime_error{std::string("Division by zero in ") + map_operation_to_string(operation)},
+      operation_{operation}, offset_{offset} {}
+
+std::ostream &operator<<(std::ostream &os, const Value &value)
+{
+    if (value.type_ == ValueType::INTEGER)
+    {
+        return os << value.integer_;
+    }
+    return os << value.real_;
+}
@@ -0,0 +1,49 @@
+#ifndef VALUE_HPP
+#define VALUE_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include "ast_node.hpp"
+#include "semantic_analyzer.hpp"
+
+/// @brief INTEGER or REAL value of a variable
+class Value
+{
+public:
+    static Value make_integer(int value) noexcept;
+    static Value make_real(double value) noexcept;
+
+    ValueType get_type() const noexcept { return type_; }
+    int get_integer() const noexcept { return integer_; }
+    double get_real() const noexcept { return real_; }
+
+    friend std::ostream &operator<<(std::ostream &os, const Value &value);
+
+private:
+    ValueType type_ = ValueType::INTEGER;
+    union
+    {
+        int integer_ = 0;
+        double real_;
+    };
+};
+
+/// @brief Error stopping a running program, raised alike by the *Interpreter*, the *StackVm*
+/// and the *RegisterVm*
+/// @note The only one is a division by zero (DIV), the message names the failing operation
+class ExecutionError : public std::runtime_error
+{
+public:
+    ExecutionError(Operation operation, std::uint32_t offset);
+
+    Operation get_operation() const noexcept { return operation_; }
+    /// @brief Offset in the source code of the operator that failed
+    std::uint32_t get_offset() const noexcept { return offset_; }
+
+private:
+    Operation operation_;
+    std::uint32_t offset_;
+};
+
+#endif
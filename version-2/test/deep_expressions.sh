@@ -0,0 +1,42 @@
+#!/bin/sh
+# Runs programs nesting an expression 100k deep through main, first parsing them and
+# saving their AST file, then from the AST file. Every pass (parser, analysis, AST file,
+# compiler) must walk such expressions without recursing once per node.
+set -e
+
+MAIN=${1:-./main}
+DEPTH=100000
+DIRECTORY=$(mktemp -d)
+trap 'rm -rf "$DIRECTORY"' EXIT
+
+# a := 1 + 1 + ... + 1, a left-leaning chain of DEPTH terms
+awk -v depth=$DEPTH 'BEGIN {
+    printf "PROGRAM Chain; VAR a : INTEGER; BEGIN a := 1"
+    for (i = 1; i < depth; i++) printf " + 1"
+    print " END."
+}' > "$DIRECTORY/chain.pas"
+
+# a := - - ... - 1, DEPTH nested signs
+awk -v depth=$DEPTH 'BEGIN {
+    printf "PROGRAM Unary; VAR a : INTEGER; BEGIN a := "
+    for (i = 0; i < depth; i++) printf "- "
+    print "1 END."
+}' > "$DIRECTORY/unary.pas"
+
+# check <program> <expected output>
+check() {
+    for run in parsed cached; do
+        output=$("$MAIN" "$DIRECTORY/$1.pas" "$DIRECTORY/$1.ast") || {
+            echo "FAIL $1 ($run): exit status $?"
+            exit 1
+        }
+        if [ "$output" != "$2" ]; then
+            echo "FAIL $1 ($run): expected '$2', got '$output'"
+            exit 1
+        fi
+    done
+    echo "ok $1"
+}
+
+check chain "a = $DEPTH"
+check unary "a = 1"